@@ -1,8 +1,16 @@
 #include "fox_config.h"
 #include "fox_display.h"
 #include "fox_canbus.h"
+#include "fox_canlog.h"
+#include "fox_sniffer.h"
 #include "fox_vehicle.h"
+#include "fox_history.h"
+#include "fox_trip.h"
+#include "fox_stats.h"
+#include "fox_events.h"
+#include "fox_i2c.h"
 #include "fox_rtc.h"
+#include "fox_heap.h"
 
 // Global variables
 int currentPage = PAGE_CLOCK;
@@ -14,18 +22,14 @@ unsigned long setupModeStart = 0;
 
 // Variables for I2C error handling
 unsigned long lastModeChangeTime = 0;
-FoxVehicleMode lastMode = MODE_UNKNOWN;
 
 // Array untuk page yang enabled
-int enabledPages[4]; // Maks 3 user pages + 1 sport
+int enabledPages[MAX_USER_PAGES + 1]; // User pages + 1 sport
 int enabledPageCount = 0;
 int currentPageIndex = 0;
 
 // Charging mode tracking
 bool wasCharging = false;
-unsigned long lastChargingDisplayUpdate = 0;
-unsigned long lastChargingLog = 0;
-unsigned long lastCANUpdate = 0;
 
 // System protection tracking
 unsigned long lastSystemCheck = 0;
@@ -42,6 +46,9 @@ void setup() {
     // Inisialisasi array enabled pages
     initEnabledPages();
     
+    // Initialize bus I2C bersama (OLED + RTC)
+    foxI2CInit();
+    
     // Initialize display
     foxDisplayInit();
     
@@ -60,10 +67,29 @@ void setup() {
         Serial.println("CAN: Failed");
     }
     
+    // Initialize CAN recorder (LittleFS)
+    if(foxCANLogInit()) {
+        Serial.println("CAN Log: OK");
+    } else {
+        Serial.println("CAN Log: Not available");
+    }
+    
     // Initialize vehicle module
     foxVehicleInit();
     Serial.println("Vehicle module initialized");
     
+    // Initialize history signal (RAM)
+    foxHistoryInit();
+    
+    // Initialize trip computer (total dari NVS)
+    foxTripInit();
+    
+    // Statistik riding per sesi (sejak boot / STATS RESET)
+    foxStatsInit();
+    
+    // Mode transition & log lewat event bus
+    subscribeLoopEvents();
+    
     // Configure button
     pinMode(BUTTON_PIN, INPUT_PULLUP);
     Serial.println("Button configured");
@@ -83,6 +109,9 @@ void setup() {
     Serial.println("=== SETUP COMPLETE ===");
     Serial.println("System running with enhanced protection");
     Serial.println("========================================");
+    
+    // Mulai sini loop() tidak boleh mengalokasi heap (cek dengan HEAP)
+    foxHeapMarkSetupDone();
 }
 
 void initEnabledPages() {
@@ -101,6 +130,10 @@ void initEnabledPages() {
         enabledPages[enabledPageCount++] = PAGE_ELECTRICAL;
     #endif
     
+    #if PAGE_TRIP_ENABLED
+        enabledPages[enabledPageCount++] = PAGE_TRIP;
+    #endif
+    
     // Sport page (always last, auto-trigger only)
     enabledPages[enabledPageCount++] = PAGE_SPORT;
     
@@ -120,6 +153,8 @@ void printPageConfiguration() {
     Serial.println(PAGE_TEMP_ENABLED ? "ENABLED" : "DISABLED");
     Serial.print("Page 3 (Electrical): ");
     Serial.println(PAGE_ELECTRICAL_ENABLED ? "ENABLED" : "DISABLED");
+    Serial.print("Page 4 (Trip): ");
+    Serial.println(PAGE_TRIP_ENABLED ? "ENABLED" : "DISABLED");
     Serial.println("Page 9 (Sport): ALWAYS ENABLED (auto-trigger)");
     Serial.print("Total user pages: ");
     Serial.println(MAX_USER_PAGES);
@@ -148,84 +183,148 @@ void printHelp() {
     #if PAGE_ELECTRICAL_ENABLED
         Serial.print("3|");
     #endif
+    #if PAGE_TRIP_ENABLED
+        Serial.print("4|");
+    #endif
     Serial.println("9] - Switch display page");
     
     Serial.println("VEHICLE       - Show vehicle data");
     Serial.println("CAPTURE ON    - Enable unknown CAN ID capture");
     Serial.println("CAPTURE OFF   - Disable unknown CAN ID capture");
+    Serial.println("SNIFF         - Show unknown CAN ID report (CAPTURE ON)");
+    Serial.println("SNIFF RESET   - Clear unknown CAN ID table");
     Serial.println("CONFIG        - Show page configuration");
-    Serial.println("I2CSTATUS     - Show I2C error statistics");
+    Serial.println("I2CSTATUS     - Show I2C bus statistics per device");
+    Serial.println("DISPSTATS     - Show display render/flush timing and FPS");
+    Serial.println("DISPSTATS RESET - Reset display statistics");
+    Serial.println("CANSTATS      - Show CAN bus statistics");
+    Serial.println("CANSTATS RESET - Reset CAN bus statistics");
+    Serial.println("LOG           - Show CAN recorder status");
+    Serial.println("LOG START/STOP - Start/stop CAN frame recorder");
+    Serial.println("LOG DUMP      - Print recorded frames (candump format)");
+    Serial.println("LOG CLEAR     - Delete recorded frames");
+    Serial.println("TRIP          - Show trip computer");
+    Serial.println("TRIP RESET    - Reset trip totals");
+    Serial.println("STATS         - Show riding statistics per mode");
+    Serial.println("STATS RESET   - Start new statistics session");
+    Serial.println("HISTORY       - Show signal history summary");
+    Serial.println("HISTORY CLEAR - Clear signal history");
+    Serial.println("EVENTS        - Show event bus subscribers");
+    Serial.println("UNKNOWNMODES  - Show learned unknown mode bytes");
     Serial.println("CLEARUNKNOWN  - Clear unknown bytes list");
     Serial.println("SYSTEMSTATUS  - Show system health status");
+    Serial.println("HEAP          - Show heap allocations since setup");
     Serial.println("==========================");
     
     printPageConfiguration();
 }
 
+// Buffer command tetap: tanpa String/readStringUntil, loop() tidak menunggu serial
+char serialCommand[SERIAL_COMMAND_MAX_LEN + 1];
+uint8_t serialCommandLen = 0;
+unsigned long serialCommandLastMs = 0;
+
+void runSerialCommand() {
+    serialCommand[serialCommandLen] = '\0';
+    serialCommandLen = 0;
+    
+    // Trim spasi di awal dan akhir
+    char* command = serialCommand;
+    while (*command == ' ' || *command == '\t') command++;
+    char* end = command + strlen(command);
+    while (end > command && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) *--end = '\0';
+    
+    handleCommand(command);
+}
+
 void processSerialCommands() {
-    if (Serial.available()) {
-        String command = Serial.readStringUntil('\n');
-        command.trim();
-        command.toUpperCase();
-        
-        handleCommand(command);
+    while (Serial.available()) {
+        char c = Serial.read();
+        serialCommandLastMs = millis();
+        if (c == '\n') {
+            runSerialCommand();
+        } else if (serialCommandLen < SERIAL_COMMAND_MAX_LEN) {
+            serialCommand[serialCommandLen++] = toupper((unsigned char)c);
+        }
     }
+    
+    // Serial monitor tanpa line ending: proses setelah jeda, sama seperti timeout readStringUntil
+    if (serialCommandLen > 0 && millis() - serialCommandLastMs >= SERIAL_COMMAND_TIMEOUT_MS) {
+        runSerialCommand();
+    }
+}
+
+bool commandStartsWith(const char* command, const char* prefix) {
+    return strncmp(command, prefix, strlen(prefix)) == 0;
 }
 
-void handleCommand(String command) {
-    if (command == "HELP") {
+void handleCommand(const char* command) {
+    if (strcmp(command, "HELP") == 0) {
         printHelp();
     }
-    else if (command.startsWith("DAY ")) {
+    else if (commandStartsWith(command, "DAY ")) {
         handleDayCommand(command);
     }
-    else if (command.startsWith("TIME ")) {
+    else if (commandStartsWith(command, "TIME ")) {
         handleTimeCommand(command);
     }
-    else if (command.startsWith("DATE ")) {
+    else if (commandStartsWith(command, "DATE ")) {
         handleDateCommand(command);
     }
-    else if (command == "DEBUG") {
+    else if (strcmp(command, "DEBUG") == 0) {
         foxRTCDebugPrint();
     }
-    else if (command == "DEBUG ON") {
+    else if (strcmp(command, "DEBUG ON") == 0) {
         showDebugInfo = true;
         Serial.println("Periodic debug enabled");
     }
-    else if (command == "DEBUG OFF") {
+    else if (strcmp(command, "DEBUG OFF") == 0) {
         showDebugInfo = false;
         Serial.println("Periodic debug disabled");
     }
-    else if (command == "SETUP") {
+    else if (strcmp(command, "SETUP") == 0) {
         setupMode = true;
         setupModeStart = millis();
         Serial.println("Setup mode active");
     }
-    else if (command == "SAVE") {
+    else if (strcmp(command, "SAVE") == 0) {
         setupMode = false;
         Serial.println("Setup mode exited");
         if(foxDisplayIsInitialized()) {
             foxDisplayUpdate(currentPage);
         }
     }
-    else if (command.startsWith("PAGE ")) {
+    else if (commandStartsWith(command, "PAGE ")) {
         handlePageCommand(command);
     }
-    else if (command == "VEHICLE") {
+    else if (strcmp(command, "VEHICLE") == 0) {
         displayVehicleData();
     }
-    else if (command == "CAPTURE ON") {
+    else if (strcmp(command, "CAPTURE ON") == 0) {
         foxVehicleEnableUnknownCapture(true);
+        foxCANSetAcceptAll(true);   // Filter hardware harus meloloskan semua ID
         Serial.println("=== CAPTURE MODE ON ===");
+        Serial.println("Ketik SNIFF untuk melihat unknown CAN ID");
+        if (!foxCANIsInitialized()) {
+            Serial.println("CAN driver tidak aktif, filter diterapkan saat driver pulih");
+        }
     }
-    else if (command == "CAPTURE OFF") {
+    else if (strcmp(command, "CAPTURE OFF") == 0) {
         foxVehicleEnableUnknownCapture(false);
+        foxCANSetAcceptAll(false);  // Kembali ke filter whitelist
         Serial.println("Capture mode disabled");
     }
-    else if (command == "CONFIG") {
+    else if (strcmp(command, "SNIFF") == 0) {
+        foxSnifferPrintReport();
+    }
+    else if (strcmp(command, "SNIFF RESET") == 0) {
+        foxSnifferReset();
+        Serial.println("Sniffer table cleared");
+    }
+    else if (strcmp(command, "CONFIG") == 0) {
         printPageConfiguration();
     }
-    else if (command == "I2CSTATUS") {
+    else if (strcmp(command, "I2CSTATUS") == 0) {
         Serial.print("I2C Error Count: ");
         Serial.println(getI2CErrorCount());
         Serial.print("Last I2C Error: ");
@@ -236,22 +335,84 @@ void handleCommand(String command) {
         } else {
             Serial.println("Never");
         }
+        foxDisplayPrintRecoveryStatus();
+        foxI2CPrintStatus();
     }
-    else if (command == "CLEARUNKNOWN") {
-        // Panggil fungsi clear unknown list jika ada
-        // foxVehicleClearUnknownList();
-        Serial.println("Feature not implemented in this version");
+    else if (strcmp(command, "DISPSTATS") == 0) {
+        foxDisplayPrintStats();
     }
-    else if (command == "SYSTEMSTATUS") {
+    else if (strcmp(command, "DISPSTATS RESET") == 0) {
+        foxDisplayResetStats();
+        Serial.println("Display statistics reset");
+    }
+    else if (strcmp(command, "CANSTATS") == 0) {
+        foxCANPrintStats();
+    }
+    else if (strcmp(command, "CANSTATS RESET") == 0) {
+        foxCANResetStats();
+        Serial.println("CAN statistics reset (TEC/REC = nilai controller saat ini)");
+    }
+    else if (strcmp(command, "LOG") == 0) {
+        foxCANLogPrintStatus();
+    }
+    else if (strcmp(command, "LOG START") == 0) {
+        foxCANLogStart();
+    }
+    else if (strcmp(command, "LOG STOP") == 0) {
+        foxCANLogStop();
+    }
+    else if (strcmp(command, "LOG DUMP") == 0) {
+        foxCANLogDump();
+    }
+    else if (strcmp(command, "LOG CLEAR") == 0) {
+        foxCANLogClear();
+    }
+    else if (strcmp(command, "TRIP") == 0) {
+        foxTripPrint();
+    }
+    else if (strcmp(command, "TRIP RESET") == 0) {
+        foxTripReset();
+        Serial.println("Trip reset");
+        if(foxDisplayIsInitialized() && currentPage == PAGE_TRIP) {
+            foxDisplayUpdate(currentPage);
+        }
+    }
+    else if (strcmp(command, "STATS") == 0) {
+        foxStatsPrint();
+    }
+    else if (strcmp(command, "STATS RESET") == 0) {
+        foxStatsReset();
+        Serial.println("Statistics reset");
+    }
+    else if (strcmp(command, "HISTORY") == 0) {
+        foxHistoryPrintStatus();
+    }
+    else if (strcmp(command, "HISTORY CLEAR") == 0) {
+        foxHistoryClear();
+        Serial.println("History cleared");
+    }
+    else if (strcmp(command, "EVENTS") == 0) {
+        foxEventPrintStatus();
+    }
+    else if (strcmp(command, "UNKNOWNMODES") == 0) {
+        foxVehiclePrintUnknownModes();
+    }
+    else if (strcmp(command, "CLEARUNKNOWN") == 0) {
+        foxVehicleClearUnknownList();
+    }
+    else if (strcmp(command, "SYSTEMSTATUS") == 0) {
         displaySystemStatus();
     }
-    else if (command.length() > 0) {
+    else if (strcmp(command, "HEAP") == 0) {
+        foxHeapPrintStatus();
+    }
+    else if (command[0] != '\0') {
         Serial.println("Unknown command");
     }
 }
 
-void handleDayCommand(String command) {
-    int dayNum = command.substring(4).toInt();
+void handleDayCommand(const char* command) {
+    int dayNum = atoi(command + 4);
     if (dayNum >= 1 && dayNum <= 7) {
         if (foxRTCSetDayOfWeek(dayNum)) {
             Serial.println("OK - Day updated");
@@ -264,9 +425,8 @@ void handleDayCommand(String command) {
     }
 }
 
-void handleTimeCommand(String command) {
-    String timeStr = command.substring(5);
-    if (foxRTCSetTimeFromString(timeStr)) {
+void handleTimeCommand(const char* command) {
+    if (foxRTCSetTimeFromString(command + 5)) {
         Serial.println("OK - Time updated");
         if(foxDisplayIsInitialized()) {
             foxDisplayUpdate(currentPage);
@@ -276,9 +436,8 @@ void handleTimeCommand(String command) {
     }
 }
 
-void handleDateCommand(String command) {
-    String dateStr = command.substring(5);
-    if (foxRTCSetDateFromString(dateStr)) {
+void handleDateCommand(const char* command) {
+    if (foxRTCSetDateFromString(command + 5)) {
         Serial.println("OK - Date updated");
         if(foxDisplayIsInitialized()) {
             foxDisplayUpdate(currentPage);
@@ -288,8 +447,8 @@ void handleDateCommand(String command) {
     }
 }
 
-void handlePageCommand(String command) {
-    int page = command.substring(5).toInt();
+void handlePageCommand(const char* command) {
+    int page = atoi(command + 5);
     
     // Validasi page berdasarkan konfigurasi
     bool isValidPage = false;
@@ -304,6 +463,9 @@ void handlePageCommand(String command) {
         case PAGE_ELECTRICAL:
             isValidPage = PAGE_ELECTRICAL_ENABLED;
             break;
+        case PAGE_TRIP:
+            isValidPage = PAGE_TRIP_ENABLED;
+            break;
         case PAGE_SPORT:
             isValidPage = true; // Sport page always valid
             break;
@@ -347,6 +509,9 @@ void handlePageCommand(String command) {
         #if PAGE_ELECTRICAL_ENABLED
             Serial.print("3 ");
         #endif
+        #if PAGE_TRIP_ENABLED
+            Serial.print("4 ");
+        #endif
         Serial.println("9");
     }
 }
@@ -363,7 +528,7 @@ int getNextUserPage() {
 }
 
 void displayVehicleData() {
-    FoxVehicleData data = foxVehicleGetData();
+    const FoxVehicleData& data = foxVehicleGetDataRef();
     Serial.println("=== VEHICLE DATA ===");
     Serial.print("Mode: ");
     Serial.println(foxVehicleModeToString(data.mode));
@@ -398,6 +563,22 @@ void displayVehicleData() {
     
     Serial.print("Data Fresh: ");
     Serial.println(foxVehicleDataIsFresh() ? "YES" : "NO");
+    
+    // Umur tiap signal, STALE = lewat SIGNAL_TIMEOUT_*
+    Serial.println("Signal age:");
+    for(uint8_t s = 0; s < SIGNAL_COUNT; s++) {
+        FoxVehicleSignal signal = (FoxVehicleSignal)s;
+        unsigned long age = foxVehicleSignalAge(signal);
+        Serial.print("  ");
+        Serial.print(foxVehicleSignalName(signal));
+        Serial.print(": ");
+        if(age == FOX_SIGNAL_AGE_NEVER) {
+            Serial.println("never");
+        } else {
+            Serial.print(age);
+            Serial.println(foxSignalValid(data, signal) ? " ms" : " ms STALE");
+        }
+    }
     Serial.println("===================");
 }
 
@@ -417,12 +598,27 @@ void displaySystemStatus() {
     Serial.print("CAN: ");
     Serial.println(foxCANIsInitialized() ? "OK" : "NOT INITIALIZED");
     
+    if(foxCANIsInitialized()) {
+        FoxCANRingStats ring = foxCANGetRingStats();
+        Serial.print("CAN Frames: ");
+        Serial.print(ring.framesReceived);
+        Serial.print(" rx, ");
+        Serial.print(ring.framesProcessed);
+        Serial.println(" processed");
+        Serial.print("CAN Ring: high-water ");
+        Serial.print(ring.highWater);
+        Serial.print("/");
+        Serial.print(ring.capacity);
+        Serial.print(", overflow ");
+        Serial.println(ring.overflowCount);
+    }
+    
     // RTC status
     Serial.print("RTC: ");
     Serial.println(foxRTCIsRunning() ? "OK" : "NOT RUNNING");
     
     // Vehicle data
-    FoxVehicleData data = foxVehicleGetData();
+    const FoxVehicleData& data = foxVehicleGetDataRef();
     Serial.print("Vehicle Mode: ");
     Serial.println(foxVehicleModeToString(data.mode));
     
@@ -436,6 +632,77 @@ void displaySystemStatus() {
     Serial.println("====================\n");
 }
 
+// ========== EVENT SUBSCRIBER ==========
+// Handler dipanggil saat data vehicle diproses (dalam loop), bukan tiap tick
+
+void onModeChangeEvent(const FoxEvent& event, void* context) {
+    FoxVehicleMode mode = (FoxVehicleMode)event.value;
+    lastModeChangeTime = millis();
+    
+    // Handle charging mode transition
+    if(mode == MODE_CHARGING && !wasCharging) {
+        Serial.println("=== CHARGING MODE ===");
+        Serial.println("Button disabled, simple display enabled");
+        wasCharging = true;
+    } else if(mode != MODE_CHARGING && wasCharging) {
+        Serial.println("=== NORMAL MODE ===");
+        Serial.println("Button enabled");
+        wasCharging = false;
+    }
+}
+
+// SOC berubah >= 1%, maksimal 1x per menit
+void onChargingLogEvent(const FoxEvent& event, void* context) {
+    const FoxVehicleData& vehicleData = foxVehicleGetDataRef();
+    if(vehicleData.mode != MODE_CHARGING) return;
+    
+    RTCDateTime dt = foxRTCGetDateTime();
+    Serial.print("[CHARGING] ");
+    Serial.print(dt.hour);
+    Serial.print(":");
+    if(dt.minute < 10) Serial.print("0");
+    Serial.print(dt.minute);
+    Serial.print(" - ");
+    Serial.print(vehicleData.soc);
+    Serial.print("% ");
+    Serial.print(vehicleData.voltage, 1);
+    Serial.println("V");
+}
+
+void onBMSLogEvent(const FoxEvent& event, void* context) {
+    const FoxVehicleData& vehicleData = foxVehicleGetDataRef();
+    if(vehicleData.mode == MODE_CHARGING) return;
+    
+    Serial.print("BMS: V=");
+    Serial.print(vehicleData.voltage, 1);
+    Serial.print("V, I=");
+    Serial.print(event.value, 1);
+    Serial.println("A");
+}
+
+void onTempAlertEvent(const FoxEvent& event, void* context) {
+    // State awal di bawah batas bukan "turun kembali", tidak perlu dilog
+    if(event.initial && !event.state) return;
+    
+    Serial.print(event.state ? "[TEMP] HIGH " : "[TEMP] OK ");
+    Serial.print(foxVehicleSignalName(event.signal));
+    Serial.print(": ");
+    Serial.print(event.value, 0);
+    Serial.println("C");
+}
+
+void subscribeLoopEvents() {
+    foxEventSubscribe("MODE", onModeChangeEvent, NULL, EVENT_MASK(EVENT_MODE_CHANGE), 0);
+    foxEventSubscribe("LOG_CHG", onChargingLogEvent, NULL, EVENT_MASK(EVENT_SIGNAL_UPDATE),
+                      EVENT_SIGNAL_MASK(SIGNAL_SOC), 1.0f, EVENT_LOG_CHARGING_INTERVAL_MS);
+    foxEventSubscribe("LOG_BMS", onBMSLogEvent, NULL, EVENT_MASK(EVENT_SIGNAL_UPDATE),
+                      EVENT_SIGNAL_MASK(SIGNAL_CURRENT), 0.0f, EVENT_LOG_BMS_INTERVAL_MS);
+    foxEventSubscribeThreshold("LOG_TCTRL", onTempAlertEvent, NULL, SIGNAL_TEMP_CONTROLLER,
+                               EVENT_LOG_TEMP_ALERT_C, EVENT_LOG_TEMP_HYST_C);
+    foxEventSubscribeThreshold("LOG_TMOT", onTempAlertEvent, NULL, SIGNAL_TEMP_MOTOR,
+                               EVENT_LOG_TEMP_ALERT_C, EVENT_LOG_TEMP_HYST_C);
+}
+
 void loop() {
     static unsigned long lastUpdate = 0;
     static unsigned long lastDebug = 0;
@@ -446,8 +713,16 @@ void loop() {
     // Process serial commands
     processSerialCommands();
     
+    // Kuras semua frame CAN yang sudah dikumpulkan task RX (non-blocking)
+    foxCANUpdate();
+    foxCANLogUpdate();
+    foxVehicleUpdate();
+    foxHistoryUpdate();
+    foxTripUpdate();
+    foxDisplayRecoveryUpdate();
+    
     // Get vehicle data
-    FoxVehicleData vehicleData = foxVehicleGetData();
+    const FoxVehicleData& vehicleData = foxVehicleGetDataRef();
     
     // ========== SYSTEM HEALTH CHECK ==========
     if(now - lastHealthCheck > 30000) { // Setiap 30 detik
@@ -471,47 +746,12 @@ void loop() {
             lastUnknownModeLog = now;
         }
         
-        // CAN update dengan throttling tinggi
-        if(foxDisplayIsInitialized() && (now - lastCANUpdate > 200)) { // 5Hz max
-            foxCANUpdate();
-            lastCANUpdate = now;
-        }
-        
         delay(10);
         return; // SKIP SEMUA DISPLAY LOGIC
     }
     
     // ========== NORMAL OPERATION ==========
-    
-    // CAN update dengan throttling berdasarkan mode
-    if(foxDisplayIsInitialized()) {
-        unsigned long canInterval = (vehicleData.mode == MODE_CHARGING) ? 200 : 50;
-        
-        if(now - lastCANUpdate > canInterval) {
-            foxCANUpdate();
-            lastCANUpdate = now;
-        }
-    }
-    
-    // Deteksi mode change
-    if(vehicleData.mode != lastMode) {
-        lastModeChangeTime = now;
-        
-        // Handle charging mode transition
-        if(vehicleData.mode == MODE_CHARGING && !wasCharging) {
-            Serial.println("=== CHARGING MODE ===");
-            Serial.println("Button disabled, simple display enabled");
-            wasCharging = true;
-            lastChargingDisplayUpdate = now;
-            lastChargingLog = now;
-        } else if(vehicleData.mode != MODE_CHARGING && wasCharging) {
-            Serial.println("=== NORMAL MODE ===");
-            Serial.println("Button enabled");
-            wasCharging = false;
-        }
-        
-        lastMode = vehicleData.mode;
-    }
+    // (mode change ditangani onModeChangeEvent lewat event bus)
     
     // ========== BUTTON HANDLING ==========
     bool buttonEnabled = (vehicleData.mode != MODE_CHARGING);
@@ -530,11 +770,6 @@ void loop() {
                 
                 Serial.print("Button pressed! Page ");
                 Serial.println(currentPage);
-                
-                if(foxDisplayIsInitialized()) {
-                    foxDisplayUpdate(currentPage);
-                }
-                lastUpdate = now;
             }
         }
         lastButton = btn;
@@ -555,23 +790,11 @@ void loop() {
                 currentPage = PAGE_SPORT;
                 Serial.println("Auto-switched to SPORT page (9)");
                 foxDisplayForceSportUpdate();
-                
-                // Immediate update untuk sport page
-                if(foxDisplayIsInitialized() && (now - lastModeChangeTime > 100)) {
-                    foxDisplayUpdate(currentPage);
-                    lastUpdate = now;
-                }
             }
         } else {
             if (currentPage == PAGE_SPORT) {
                 currentPage = lastNormalPage;
                 Serial.println("Returned to normal page");
-                
-                // Update display setelah kembali dari sport
-                if(foxDisplayIsInitialized() && (now - lastModeChangeTime > 100)) {
-                    foxDisplayUpdate(currentPage);
-                    lastUpdate = now;
-                }
             }
         }
     }
@@ -595,50 +818,9 @@ void loop() {
             }
         }
     } 
-    else if (vehicleData.mode == MODE_CHARGING) {
-        // ========== CHARGING MODE ==========
-        if(now - lastChargingDisplayUpdate > UPDATE_INTERVAL_CHARGING_MS) {
-            if(foxDisplayIsInitialized()) {
-                foxDisplayUpdate(99); // Charging display page
-            }
-            lastChargingDisplayUpdate = now;
-            lastUpdate = now;
-            
-            // Minimal logging (60 detik sekali)
-            if(now - lastChargingLog > 60000) {
-                RTCDateTime dt = foxRTCGetDateTime();
-                Serial.print("[CHARGING] ");
-                Serial.print(dt.hour);
-                Serial.print(":");
-                if(dt.minute < 10) Serial.print("0");
-                Serial.print(dt.minute);
-                Serial.print(" - ");
-                Serial.print(vehicleData.soc);
-                Serial.print("% ");
-                Serial.print(vehicleData.voltage, 1);
-                Serial.println("V");
-                lastChargingLog = now;
-            }
-        }
-    }
-    else if (currentPage == PAGE_SPORT) {
-        // Sport page update dengan throttle
-        bool isCruiseMode = (vehicleData.mode == MODE_CRUISE || 
-                            vehicleData.mode == MODE_SPORT_CRUISE);
-        
-        unsigned long interval = isCruiseMode ? 200 : UPDATE_INTERVAL_SPORT_MS;
-        
-        if(foxDisplayIsInitialized() && (now - lastModeChangeTime > 100) && (now - lastUpdate > interval)) {
-            foxDisplayUpdate(currentPage);
-            lastUpdate = now;
-        }
-    }
-    else {
-        // Normal pages
-        if(foxDisplayIsInitialized() && (now - lastModeChangeTime > 500) && (now - lastUpdate > UPDATE_INTERVAL_NORMAL_MS)) {
-            foxDisplayUpdate(currentPage);
-            lastUpdate = now;
-        }
+    else if(foxDisplayIsInitialized()) {
+        // Render scheduler: page dirender hanya saat isinya berubah (batas FPS di fox_display)
+        foxDisplayUpdate(vehicleData.mode == MODE_CHARGING ? PAGE_CHARGING : currentPage);
     }
     
     // ========== DEBUG INFO ==========
@@ -653,6 +835,8 @@ void loop() {
                 Serial.print("TEMP");
             } else if(currentPage == PAGE_ELECTRICAL) {
                 Serial.print("ELECTRICAL");
+            } else if(currentPage == PAGE_TRIP) {
+                Serial.print("TRIP");
             } else {
                 Serial.print("CLOCK");
             }
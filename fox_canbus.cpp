@@ -1,37 +1,446 @@
 #include "fox_canbus.h"
 #include "fox_config.h"
 #include "fox_vehicle.h"
+#include "fox_candb.h"
 #include <Arduino.h>
+#include <atomic>
 
 #ifdef ESP32
 #include <driver/twai.h>
 #endif
 
-bool canInitialized = false;
+#if (CAN_RX_RING_SIZE & (CAN_RX_RING_SIZE - 1)) != 0
+#error "CAN_RX_RING_SIZE harus pangkat 2"
+#endif
+
+// Ditulis loop (foxCANInit) dan task RX (reinstall driver), dibaca keduanya dari core berbeda
+std::atomic<bool> canInitialized(false);
+
+// ========== RX RING BUFFER (SINGLE PRODUCER / SINGLE CONSUMER) ==========
+// Producer: canRxTask (core CAN_RX_TASK_CORE)
+// Consumer: foxCANUpdate() dari loop()
+// Index berjalan bebas (free-running), posisi slot = index & mask
+#define CAN_RX_RING_MASK (CAN_RX_RING_SIZE - 1)
+
+FoxCANFrame rxRing[CAN_RX_RING_SIZE];
+std::atomic<uint32_t> rxHead(0);    // Hanya ditulis producer
+std::atomic<uint32_t> rxTail(0);    // Hanya ditulis consumer
+
+// Counter producer
+volatile uint32_t rxFramesReceived = 0;
+volatile uint32_t rxOverflowCount = 0;
+volatile uint16_t rxHighWater = 0;
+
+// Counter consumer
+uint32_t rxFramesProcessed = 0;
+
+// Fungsi: Masukkan frame ke ring, false jika ring penuh (frame dibuang)
+static bool ringPush(uint32_t id, const uint8_t* data, uint8_t len, uint32_t timestampUs) {
+    uint32_t head = rxHead.load(std::memory_order_relaxed);
+    uint32_t tail = rxTail.load(std::memory_order_acquire);
+    uint32_t used = head - tail;
+
+    if(used >= CAN_RX_RING_SIZE) {
+        rxOverflowCount++;
+        return false;
+    }
+
+    FoxCANFrame& frame = rxRing[head & CAN_RX_RING_MASK];
+    frame.id = id;
+    frame.timestampUs = timestampUs;
+    frame.len = (len > 8) ? 8 : len;
+    memcpy(frame.data, data, frame.len);
+
+    rxHead.store(head + 1, std::memory_order_release);
+
+    rxFramesReceived++;
+    if(used + 1 > rxHighWater) {
+        rxHighWater = used + 1;
+    }
+    return true;
+}
+
+// Counter bus-off (ditulis task RX)
+volatile uint32_t canBusOffCount = 0;
+volatile uint32_t canBusRecoveredCount = 0;
+
+// Nilai counter saat CANSTATS RESET. Counter milik task RX dan driver TWAI tidak
+// di-nol-kan dari loop (race dengan increment), statistik = nilai - baseline.
+struct CANCounterBase {
+    uint32_t framesReceived;
+    uint32_t overflowCount;
+    uint32_t busOffCount;
+    uint32_t busRecoveredCount;
+    uint32_t rxMissed;
+    uint32_t rxOverrun;
+    uint32_t busErrors;
+    uint32_t arbLost;
+};
+
+CANCounterBase canCounterBase = {};
+
+// Counter driver kembali ke 0 setelah driver di-install ulang
+static uint32_t sinceBase(uint32_t value, uint32_t& base) {
+    if(value < base) base = 0;
+    return value - base;
+}
+
+// ========== STATISTIK PER ID ==========
+// Dihitung di foxCANUpdate() dari timestamp frame, O(1) per frame.
+// Index 0..FOX_CAN_MESSAGE_COUNT-1 = message dikenal, index terakhir = ID lain.
+#define CAN_STATS_SLOTS (FOX_CAN_MESSAGE_COUNT + 1)
+#define CAN_STATS_OTHER FOX_CAN_MESSAGE_COUNT
+#define CAN_STATS_WINDOW_US 1000000UL
+
+struct CANIdAccumulator {
+    uint32_t frames;
+    uint32_t dlcMismatch;
+    uint32_t lastTimestampUs;
+    uint32_t minIntervalUs;
+    uint32_t maxIntervalUs;
+    uint64_t sumIntervalUs;
+    uint32_t intervalCount;
+    uint32_t windowStartUs;
+    uint16_t windowFrames;
+    uint16_t framesPerSec;
+};
+
+CANIdAccumulator canIdStats[CAN_STATS_SLOTS];
+
+// Beban bus dari frame yang lolos filter (jendela 1 detik)
+uint32_t busWindowStartUs = 0;
+uint32_t busWindowBits = 0;
+uint32_t busWindowFrames = 0;
+uint32_t busLastBits = 0;
+uint32_t busLastFrames = 0;
+
+// Bit nominal extended data frame tanpa stuffing: 67 bit overhead + data
+#define CAN_EXT_FRAME_BITS(len) (67 + 8 * (uint32_t)(len))
+
+static void accountFrame(const FoxCANFrame& frame) {
+    int8_t m = foxCANFindMessage(frame.id);
+    uint8_t slot = (m < 0) ? CAN_STATS_OTHER : (uint8_t)m;
+    CANIdAccumulator& acc = canIdStats[slot];
+    uint32_t ts = frame.timestampUs;
+
+    if(m >= 0 && frame.len < FOX_CAN_MESSAGES[m].dlc) {
+        acc.dlcMismatch++;
+    }
+
+    if(acc.frames > 0) {
+        uint32_t interval = ts - acc.lastTimestampUs;
+        if(acc.intervalCount == 0 || interval < acc.minIntervalUs) acc.minIntervalUs = interval;
+        if(interval > acc.maxIntervalUs) acc.maxIntervalUs = interval;
+        acc.sumIntervalUs += interval;
+        acc.intervalCount++;
+    } else {
+        acc.windowStartUs = ts;
+    }
+    acc.lastTimestampUs = ts;
+    acc.frames++;
+
+    if(ts - acc.windowStartUs >= CAN_STATS_WINDOW_US) {
+        acc.framesPerSec = acc.windowFrames;
+        acc.windowFrames = 0;
+        acc.windowStartUs = ts;
+    }
+    acc.windowFrames++;
+
+    if(ts - busWindowStartUs >= CAN_STATS_WINDOW_US) {
+        busLastBits = busWindowBits;
+        busLastFrames = busWindowFrames;
+        busWindowBits = 0;
+        busWindowFrames = 0;
+        busWindowStartUs = ts;
+    }
+    busWindowBits += CAN_EXT_FRAME_BITS(frame.len);
+    busWindowFrames++;
+}
 
-bool foxCANInit() {
 #ifdef ESP32
+TaskHandle_t canRxTaskHandle = NULL;
+
+// ========== HARDWARE ACCEPTANCE FILTER ==========
+// Dihitung dari FOX_CAN_MESSAGES (semua extended 29-bit ID).
+// Single filter: code[31:3] = ID[28:0], bit mask 1 = don't care.
+// Dual filter (extended): tiap filter hanya membandingkan ID[28:13].
+// Dipilih mode yang meloloskan ruang ID paling kecil.
+static_assert(FOX_CAN_MESSAGE_COUNT <= 16, "Pencarian dual filter dibatasi 16 ID");
+
+bool canAcceptAll = false;
+bool canTargetAcceptAll = false;            // Filter yang diminta terakhir (target reinstall)
+std::atomic<int8_t> canFilterRequest(-1);   // -1 = tidak ada, 0 = whitelist, 1 = accept all
+uint32_t canLastRetryMs = 0;
+
+// Hasil ganti filter / reinstall dari task RX, dilaporkan ke Serial oleh foxCANUpdate()
+enum CANDriverEvent : uint8_t {
+    CAN_DRIVER_EVENT_NONE = 0,
+    CAN_DRIVER_EVENT_APPLIED,       // Filter baru aktif
+    CAN_DRIVER_EVENT_REVERTED,      // Filter baru gagal, kembali ke filter lama
+    CAN_DRIVER_EVENT_DOWN,          // Filter baru dan lama gagal, driver mati
+    CAN_DRIVER_EVENT_RECOVERED      // Reinstall periodik berhasil
+};
+std::atomic<uint8_t> canDriverEvent(CAN_DRIVER_EVENT_NONE);
+
+// Fungsi: OR dari semua bit yang berbeda dalam satu grup ID
+static uint32_t idDiffBits(const uint32_t* ids, uint8_t count, uint32_t groupMask, uint8_t shift) {
+    uint32_t base = 0;
+    uint32_t diff = 0;
+    bool first = true;
+    for(uint8_t i = 0; i < count; i++) {
+        if(!(groupMask & (1UL << i))) continue;
+        uint32_t id = ids[i] >> shift;
+        if(first) {
+            base = id;
+            first = false;
+        }
+        diff |= id ^ base;
+    }
+    return diff;
+}
+
+static uint32_t idGroupBase(const uint32_t* ids, uint8_t count, uint32_t groupMask, uint8_t shift) {
+    for(uint8_t i = 0; i < count; i++) {
+        if(groupMask & (1UL << i)) return ids[i] >> shift;
+    }
+    return 0;
+}
+
+static twai_filter_config_t buildAcceptanceFilter(bool verbose) {
+    const uint8_t count = FOX_CAN_MESSAGE_COUNT;
+    const uint32_t allMask = (1UL << count) - 1;
+    uint32_t canKnownIds[FOX_CAN_MESSAGE_COUNT];
+    for(uint8_t i = 0; i < count; i++) {
+        canKnownIds[i] = FOX_CAN_MESSAGES[i].canId;
+    }
+
+    // Single filter: semua ID dalam satu code/mask
+    uint32_t singleDiff = idDiffBits(canKnownIds, count, allMask, 0);
+    uint64_t singleSpace = 1ULL << __builtin_popcount(singleDiff);
+
+    // Dual filter: cari pembagian dua grup dengan ruang ID terkecil.
+    // Bit 0 selalu di grup A supaya tiap pembagian hanya dicoba sekali.
+    uint64_t dualSpace = UINT64_MAX;
+    uint32_t bestGroupA = allMask;
+    for(uint32_t groupA = 1; groupA < allMask; groupA += 2) {
+        uint32_t groupB = allMask & ~groupA;
+        uint32_t diffA = idDiffBits(canKnownIds, count, groupA, 13);
+        uint32_t diffB = idDiffBits(canKnownIds, count, groupB, 13);
+        uint64_t space = (1ULL << (13 + __builtin_popcount(diffA))) +
+                         (1ULL << (13 + __builtin_popcount(diffB)));
+        if(space < dualSpace) {
+            dualSpace = space;
+            bestGroupA = groupA;
+        }
+    }
+
+    twai_filter_config_t f_config;
+    if(singleSpace <= dualSpace) {
+        f_config.single_filter = true;
+        f_config.acceptance_code = canKnownIds[0] << 3;
+        f_config.acceptance_mask = (singleDiff << 3) | 0x7;  // RTR & bit kosong = don't care
+        if(verbose) {
+            Serial.print("CAN filter: single, ");
+            Serial.print((uint32_t)singleSpace);
+        }
+    } else {
+        uint32_t groupB = allMask & ~bestGroupA;
+        uint32_t codeA = idGroupBase(canKnownIds, count, bestGroupA, 13) & 0xFFFF;
+        uint32_t codeB = idGroupBase(canKnownIds, count, groupB, 13) & 0xFFFF;
+        uint32_t maskA = idDiffBits(canKnownIds, count, bestGroupA, 13) & 0xFFFF;
+        uint32_t maskB = idDiffBits(canKnownIds, count, groupB, 13) & 0xFFFF;
+        f_config.single_filter = false;
+        f_config.acceptance_code = (codeA << 16) | codeB;
+        f_config.acceptance_mask = (maskA << 16) | maskB;
+        if(verbose) {
+            Serial.print("CAN filter: dual, ");
+            Serial.print((uint32_t)dualSpace);
+        }
+    }
+    if(verbose) {
+        Serial.print(" ID lolos, code=0x");
+        Serial.print(f_config.acceptance_code, HEX);
+        Serial.print(" mask=0x");
+        Serial.println(f_config.acceptance_mask, HEX);
+    }
+
+    return f_config;
+}
+
+// Fungsi: Install + start driver TWAI dengan filter yang dipilih.
+// verbose = false untuk retry periodik supaya Serial tidak dibanjiri pesan gagal.
+static bool canDriverStart(bool acceptAll, bool verbose = true) {
     twai_general_config_t g_config = TWAI_GENERAL_CONFIG_DEFAULT(
         (gpio_num_t)CAN_TX_PIN,
         (gpio_num_t)CAN_RX_PIN,
         (twai_mode_t)CAN_MODE
     );
-    
+    g_config.rx_queue_len = CAN_RX_QUEUE_LEN;
+    g_config.alerts_enabled = TWAI_ALERT_RX_DATA | TWAI_ALERT_RX_QUEUE_FULL |
+                              TWAI_ALERT_BUS_OFF | TWAI_ALERT_BUS_RECOVERED;
+
     twai_timing_config_t t_config = TWAI_TIMING_CONFIG_250KBITS();
-    twai_filter_config_t f_config = TWAI_FILTER_CONFIG_ACCEPT_ALL();
+    twai_filter_config_t f_config;
+    if(acceptAll) {
+        f_config = TWAI_FILTER_CONFIG_ACCEPT_ALL();
+        if(verbose) Serial.println("CAN filter: accept all");
+    } else {
+        f_config = buildAcceptanceFilter(verbose);
+    }
 
     if (twai_driver_install(&g_config, &t_config, &f_config) != ESP_OK) {
-        Serial.println("Gagal install CAN driver");
+        if(verbose) Serial.println("Gagal install CAN driver");
         return false;
     }
-    
+
     if (twai_start() != ESP_OK) {
-        Serial.println("Gagal start CAN bus");
+        if(verbose) Serial.println("Gagal start CAN bus");
+        twai_driver_uninstall();
         return false;
     }
 
-    Serial.println("CAN siap");
+    canAcceptAll = acceptAll;
+    return true;
+}
+
+// Filter hanya bisa diganti lewat reinstall driver.
+// Dijalankan di task RX supaya tidak ada panggilan twai_* yang sedang berjalan.
+static void canApplyFilterRequest() {
+    int8_t request = canFilterRequest.exchange(-1);
+    if(request < 0) {
+        return;
+    }
+    canTargetAcceptAll = (request == 1);
+
+    // Driver mati: permintaan hanya mengganti target reinstall berikutnya
+    if(!canInitialized || canTargetAcceptAll == canAcceptAll) {
+        return;
+    }
+
+    twai_stop();
+    twai_driver_uninstall();
+    if(canDriverStart(canTargetAcceptAll)) {
+        canDriverEvent.store(CAN_DRIVER_EVENT_APPLIED);
+        return;
+    }
+
+    // Coba kembali ke konfigurasi sebelumnya
+    if(canDriverStart(canAcceptAll)) {
+        canDriverEvent.store(CAN_DRIVER_EVENT_REVERTED);
+    } else {
+        canInitialized = false;
+        canLastRetryMs = millis();
+        canDriverEvent.store(CAN_DRIVER_EVENT_DOWN);
+    }
+}
+
+// Fungsi: Install ulang driver yang mati, dengan filter target, tiap CAN_DRIVER_RETRY_MS
+static void canRetryDriverStart() {
+    if(millis() - canLastRetryMs < CAN_DRIVER_RETRY_MS) {
+        return;
+    }
+    canLastRetryMs = millis();
+
+    if(canDriverStart(canTargetAcceptAll, false)) {
+        canInitialized = true;
+        canDriverEvent.store(CAN_DRIVER_EVENT_RECOVERED);
+    }
+}
+
+// Task RX: tidur sampai ada alert RX, lalu kuras semua frame dari driver
+static void canRxTask(void* arg) {
+    uint32_t alerts;
+    twai_message_t message;
+
+    for(;;) {
+        canApplyFilterRequest();
+
+        if(!canInitialized) {
+            // Driver gagal di-install ulang: coba lagi berkala, jangan busy-loop
+            canRetryDriverStart();
+            if(!canInitialized) {
+                vTaskDelay(pdMS_TO_TICKS(CAN_RX_ALERT_TIMEOUT_MS));
+                continue;
+            }
+        }
+
+        if(twai_read_alerts(&alerts, pdMS_TO_TICKS(CAN_RX_ALERT_TIMEOUT_MS)) != ESP_OK) {
+            continue;
+        }
+
+        if(alerts & (TWAI_ALERT_RX_DATA | TWAI_ALERT_RX_QUEUE_FULL)) {
+            while(twai_receive(&message, 0) == ESP_OK) {
+                if(message.rtr) continue;
+                ringPush(message.identifier, message.data, message.data_length_code, micros());
+            }
+        }
+
+        // Bus-off: mulai recovery, lalu start ulang setelah controller pulih
+        if(alerts & TWAI_ALERT_BUS_OFF) {
+            canBusOffCount++;
+            twai_initiate_recovery();
+        }
+        if(alerts & TWAI_ALERT_BUS_RECOVERED) {
+            if(twai_start() == ESP_OK) {
+                canBusRecoveredCount++;
+            }
+        }
+    }
+}
+
+// Fungsi: Laporkan hasil ganti filter (CAPTURE ON/OFF) dan status driver dari loop()
+static void canReportDriverEvent() {
+    uint8_t event = canDriverEvent.exchange(CAN_DRIVER_EVENT_NONE);
+    const char* target = canTargetAcceptAll ? "accept all" : "whitelist";
+
+    switch(event) {
+        case CAN_DRIVER_EVENT_APPLIED:
+            Serial.print("CAN filter aktif: ");
+            Serial.println(target);
+            break;
+        case CAN_DRIVER_EVENT_REVERTED:
+            Serial.print("CAN: gagal ganti filter ke ");
+            Serial.print(target);
+            Serial.println(", filter lama tetap aktif");
+            if(canTargetAcceptAll) {
+                Serial.println("CAPTURE hanya melihat ID whitelist");
+            }
+            break;
+        case CAN_DRIVER_EVENT_DOWN:
+            Serial.print("CAN: driver gagal di-install ulang, RX berhenti. Retry tiap ");
+            Serial.print(CAN_DRIVER_RETRY_MS);
+            Serial.println(" ms");
+            break;
+        case CAN_DRIVER_EVENT_RECOVERED:
+            Serial.print("CAN: driver pulih, filter ");
+            Serial.println(target);
+            break;
+        default:
+            break;
+    }
+}
+#endif
+
+bool foxCANInit() {
+#ifdef ESP32
+    if(!canDriverStart(false)) {
+        return false;
+    }
+
+    // Set sebelum task dibuat: task RX yang langsung jalan di core lain tidak boleh
+    // mengira driver mati lalu install ulang driver yang sedang berjalan
     canInitialized = true;
+    if (xTaskCreatePinnedToCore(canRxTask, "canRx", CAN_RX_TASK_STACK, NULL,
+                                CAN_RX_TASK_PRIORITY, &canRxTaskHandle,
+                                CAN_RX_TASK_CORE) != pdPASS) {
+        Serial.println("Gagal membuat task CAN RX");
+        canInitialized = false;
+        twai_stop();
+        twai_driver_uninstall();
+        return false;
+    }
+
+    Serial.println("CAN siap");
     return true;
 #else
     Serial.println("CAN hanya untuk ESP32");
@@ -39,17 +448,160 @@ bool foxCANInit() {
 #endif
 }
 
+// Ganti antara filter whitelist dan accept-all (untuk CAPTURE ON).
+// Non-blocking: diterapkan oleh task RX dalam CAN_RX_ALERT_TIMEOUT_MS,
+// hasilnya (termasuk gagal install ulang) dicetak oleh foxCANUpdate().
+void foxCANSetAcceptAll(bool acceptAll) {
+#ifdef ESP32
+    canFilterRequest.store(acceptAll ? 1 : 0);
+#endif
+}
+
 bool foxCANIsInitialized() {
     return canInitialized;
 }
 
+// Kuras ring buffer dan kirim setiap frame ke vehicle module.
+// Tidak pernah blocking, aman dipanggil setiap iterasi loop().
 void foxCANUpdate() {
 #ifdef ESP32
-    twai_message_t message;
-    
-    if(twai_receive(&message, pdMS_TO_TICKS(50)) == ESP_OK) {
-        // Kirim data ke vehicle module untuk diproses
-        foxVehicleUpdateFromCAN(message.identifier, message.data, message.data_length_code);
+    canReportDriverEvent();
+#endif
+
+    uint32_t tail = rxTail.load(std::memory_order_relaxed);
+    uint32_t head = rxHead.load(std::memory_order_acquire);
+
+    while(tail != head) {
+        const FoxCANFrame& frame = rxRing[tail & CAN_RX_RING_MASK];
+        accountFrame(frame);
+        foxVehicleUpdateFromCAN(frame.id, frame.data, frame.len, frame.timestampUs);
+
+        tail++;
+        rxTail.store(tail, std::memory_order_release);
+        rxFramesProcessed++;
+    }
+}
+
+FoxCANRingStats foxCANGetRingStats() {
+    FoxCANRingStats stats;
+    stats.framesReceived = rxFramesReceived - canCounterBase.framesReceived;
+    stats.framesProcessed = rxFramesProcessed;
+    stats.overflowCount = rxOverflowCount - canCounterBase.overflowCount;
+    stats.highWater = rxHighWater;
+    stats.capacity = CAN_RX_RING_SIZE;
+    return stats;
+}
+
+uint8_t foxCANGetIdStatsCount() {
+    return CAN_STATS_SLOTS;
+}
+
+bool foxCANGetIdStats(uint8_t index, FoxCANIdStats& out) {
+    if(index >= CAN_STATS_SLOTS) return false;
+
+    const CANIdAccumulator& acc = canIdStats[index];
+    uint32_t now = micros();
+
+    out.canId = (index == CAN_STATS_OTHER) ? 0 : FOX_CAN_MESSAGES[index].canId;
+    out.frames = acc.frames;
+    // ID yang berhenti datang tidak boleh tetap terlihat punya rate
+    out.framesPerSec = (acc.frames > 0 && now - acc.lastTimestampUs < 2 * CAN_STATS_WINDOW_US)
+                       ? acc.framesPerSec : 0;
+    out.minIntervalUs = acc.minIntervalUs;
+    out.maxIntervalUs = acc.maxIntervalUs;
+    out.avgIntervalUs = (acc.intervalCount > 0) ? (uint32_t)(acc.sumIntervalUs / acc.intervalCount) : 0;
+    out.dlcMismatch = acc.dlcMismatch;
+    out.throttleDrops = (index == CAN_STATS_OTHER) ? 0 : foxVehicleGetSupersededCount(index);
+    return true;
+}
+
+FoxCANBusStats foxCANGetBusStats() {
+    FoxCANBusStats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    bool recent = (micros() - busWindowStartUs < 2 * CAN_STATS_WINDOW_US);
+    stats.framesPerSec = recent ? busLastFrames : 0;
+    stats.busLoadPercent = recent ? (busLastBits * 100.0f) / CAN_BAUDRATE : 0.0f;
+    stats.busOffCount = canBusOffCount - canCounterBase.busOffCount;
+    stats.busRecoveredCount = canBusRecoveredCount - canCounterBase.busRecoveredCount;
+
+#ifdef ESP32
+    twai_status_info_t status;
+    if(canInitialized && twai_get_status_info(&status) == ESP_OK) {
+        stats.errorState = (uint8_t)status.state;
+        stats.rxMissed = sinceBase(status.rx_missed_count, canCounterBase.rxMissed);
+        stats.rxOverrun = sinceBase(status.rx_overrun_count, canCounterBase.rxOverrun);
+        stats.busErrors = sinceBase(status.bus_error_count, canCounterBase.busErrors);
+        stats.arbLost = sinceBase(status.arb_lost_count, canCounterBase.arbLost);
+        stats.txErrorCounter = status.tx_error_counter;
+        stats.rxErrorCounter = status.rx_error_counter;
     }
 #endif
+    return stats;
+}
+
+// Reset semua counter CANSTATS. TEC/REC dan state TWAI adalah nilai saat ini, bukan counter.
+void foxCANResetStats() {
+    memset(canIdStats, 0, sizeof(canIdStats));
+    busWindowBits = 0;
+    busWindowFrames = 0;
+    busLastBits = 0;
+    busLastFrames = 0;
+
+    // Kolom Drop
+    foxVehicleResetSupersededCounts();
+
+    canCounterBase.framesReceived = rxFramesReceived;
+    canCounterBase.overflowCount = rxOverflowCount;
+    canCounterBase.busOffCount = canBusOffCount;
+    canCounterBase.busRecoveredCount = canBusRecoveredCount;
+    rxFramesProcessed = 0;
+    rxHighWater = 0;    // Race dengan producer hanya bisa menulis nilai isi ring yang valid
+
+#ifdef ESP32
+    twai_status_info_t status;
+    if(canInitialized && twai_get_status_info(&status) == ESP_OK) {
+        canCounterBase.rxMissed = status.rx_missed_count;
+        canCounterBase.rxOverrun = status.rx_overrun_count;
+        canCounterBase.busErrors = status.bus_error_count;
+        canCounterBase.arbLost = status.arb_lost_count;
+    }
+#endif
+}
+
+void foxCANPrintStats() {
+    const char* stateNames[] = {"STOPPED", "RUNNING", "BUS-OFF", "RECOVERING"};
+
+    Serial.println("\n=== CAN STATISTICS ===");
+    Serial.println("ID         Frames  f/s  min/avg/max ms      DLC  Drop");
+    for(uint8_t i = 0; i < CAN_STATS_SLOTS; i++) {
+        FoxCANIdStats st;
+        foxCANGetIdStats(i, st);
+        if(i == CAN_STATS_OTHER) {
+            if(st.frames == 0) continue;
+            Serial.print("OTHER     ");
+        } else {
+            Serial.printf("0x%08lX ", (unsigned long)st.canId);
+        }
+        Serial.printf("%7lu %4u  %6.1f/%6.1f/%6.1f %4lu %5lu\n",
+                      (unsigned long)st.frames, st.framesPerSec,
+                      st.minIntervalUs / 1000.0f, st.avgIntervalUs / 1000.0f, st.maxIntervalUs / 1000.0f,
+                      (unsigned long)st.dlcMismatch, (unsigned long)st.throttleDrops);
+    }
+
+    FoxCANBusStats bus = foxCANGetBusStats();
+    FoxCANRingStats ring = foxCANGetRingStats();
+    Serial.printf("Bus load: %.1f%% (%lu f/s, frame yang lolos filter)\n",
+                  bus.busLoadPercent, (unsigned long)bus.framesPerSec);
+    Serial.printf("TWAI state: %s  TEC:%u REC:%u\n",
+                  bus.errorState < 4 ? stateNames[bus.errorState] : "?",
+                  bus.txErrorCounter, bus.rxErrorCounter);
+    Serial.printf("RX missed: %lu  RX overrun: %lu  Bus errors: %lu  Arb lost: %lu\n",
+                  (unsigned long)bus.rxMissed, (unsigned long)bus.rxOverrun,
+                  (unsigned long)bus.busErrors, (unsigned long)bus.arbLost);
+    Serial.printf("Bus-off: %lu  Recovered: %lu\n",
+                  (unsigned long)bus.busOffCount, (unsigned long)bus.busRecoveredCount);
+    Serial.printf("Ring overflow: %lu  High-water: %u/%u\n",
+                  (unsigned long)ring.overflowCount, ring.highWater, ring.capacity);
+    Serial.println("======================");
 }
@@ -3,8 +3,59 @@
 
 #include <Arduino.h>
 
+// Satu frame CAN di ring buffer RX
+struct FoxCANFrame {
+    uint32_t id;
+    uint32_t timestampUs;   // micros() saat frame diambil dari driver
+    uint8_t len;
+    uint8_t data[8];
+};
+
+// Statistik ring buffer RX
+struct FoxCANRingStats {
+    uint32_t framesReceived;    // Frame masuk ring (producer)
+    uint32_t framesProcessed;   // Frame diproses foxCANUpdate() (consumer)
+    uint32_t overflowCount;     // Frame dibuang karena ring penuh
+    uint16_t highWater;         // Isi ring tertinggi yang pernah tercapai
+    uint16_t capacity;
+};
+
+// Statistik per CAN ID (canId 0 = semua ID lain / tidak dikenal)
+struct FoxCANIdStats {
+    uint32_t canId;
+    uint32_t frames;
+    uint16_t framesPerSec;      // Frame pada jendela 1 detik terakhir
+    uint32_t minIntervalUs;     // Inter-arrival time
+    uint32_t avgIntervalUs;
+    uint32_t maxIntervalUs;
+    uint32_t dlcMismatch;       // Frame lebih pendek dari DLC di fox_candb.h
+    uint32_t throttleDrops;     // Payload tertimpa di mailbox sebelum di-decode
+};
+
+// Statistik global bus + counter controller TWAI
+struct FoxCANBusStats {
+    float busLoadPercent;
+    uint32_t framesPerSec;
+    uint8_t errorState;         // twai_state_t
+    uint8_t txErrorCounter;
+    uint8_t rxErrorCounter;
+    uint32_t rxMissed;
+    uint32_t rxOverrun;
+    uint32_t busErrors;
+    uint32_t arbLost;
+    uint32_t busOffCount;
+    uint32_t busRecoveredCount;
+};
+
 bool foxCANInit();
 void foxCANUpdate();
 bool foxCANIsInitialized();
+void foxCANSetAcceptAll(bool acceptAll);
+FoxCANRingStats foxCANGetRingStats();
+uint8_t foxCANGetIdStatsCount();
+bool foxCANGetIdStats(uint8_t index, FoxCANIdStats& out);
+FoxCANBusStats foxCANGetBusStats();
+void foxCANResetStats();
+void foxCANPrintStats();
 
 #endif
@@ -0,0 +1,250 @@
+#ifndef FOX_CANDB_H
+#define FOX_CANDB_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+#include <utility>
+#include "fox_config.h"
+
+// =============================================
+// CAN SIGNAL DATABASE (mirip DBC, di-expand saat compile)
+// =============================================
+// Menambah signal hasil reverse-engineering baru:
+//   1. Tambah nama di enum FoxCANSignal
+//   2. Tambah satu baris di FOX_CAN_SIGNALS (urutan sama dengan enum)
+// Nilainya langsung tersedia lewat foxVehicleGetSignal().
+//
+// Penomoran bit mengikuti DBC:
+//   FOX_INTEL    : startBit = posisi LSB (byte * 8 + bit), little endian
+//   FOX_MOTOROLA : startBit = posisi MSB (byte * 8 + bit), big endian
+
+enum FoxByteOrder : uint8_t {
+    FOX_INTEL = 0,
+    FOX_MOTOROLA = 1
+};
+
+struct FoxCANMessageDef {
+    uint32_t canId;
+    uint8_t dlc;                // DLC minimal, frame lebih pendek dibuang
+    uint16_t decodeIntervalMs;  // Interval decode mailbox (lihat fox_vehicle.cpp)
+};
+
+struct FoxCANSignalDef {
+    uint8_t signal;             // Harus sama dengan index di tabel
+    uint32_t canId;
+    uint8_t startBit;
+    uint8_t length;
+    FoxByteOrder order;
+    bool isSigned;
+    float scale;
+    float offset;
+};
+
+// Signal mentah hasil decode (nilai fisik = raw * scale + offset)
+enum FoxCANSignal : uint8_t {
+    CANSIG_MODE_BYTE = 0,
+    CANSIG_RPM,
+    CANSIG_TEMP_CTRL,
+    CANSIG_TEMP_MOTOR,
+    CANSIG_SPEED,
+    CANSIG_BATT_TEMP_1,
+    CANSIG_BATT_TEMP_2,
+    CANSIG_BATT_TEMP_3,
+    CANSIG_BATT_TEMP_4,
+    CANSIG_BATT_TEMP_5,
+    CANSIG_BATT_TEMP_SGL,
+    CANSIG_VOLTAGE,
+    CANSIG_CURRENT,
+    CANSIG_SOC_RAW,
+    CANSIG_COUNT
+};
+
+// Message yang dikenal (juga sumber acceptance filter TWAI)
+constexpr FoxCANMessageDef FOX_CAN_MESSAGES[] = {
+    // CAN ID                  DLC  Decode interval
+    { FOX_CAN_MODE_STATUS,     8,   CAN_DECODE_INTERVAL_MODE_MS },
+    { FOX_CAN_TEMP_CTRL_MOT,   6,   CAN_DECODE_INTERVAL_SPEED_MS },
+    { FOX_CAN_TEMP_BATT_5S,    5,   CAN_DECODE_INTERVAL_BATT_TEMP_MS },
+    { FOX_CAN_TEMP_BATT_SGL,   6,   CAN_DECODE_INTERVAL_BATT_TEMP_MS },
+    { FOX_CAN_VOLTAGE_CURRENT, 4,   CAN_DECODE_INTERVAL_VOLTAGE_MS },
+    { FOX_CAN_SOC,             2,   CAN_DECODE_INTERVAL_SOC_MS },
+};
+constexpr uint8_t FOX_CAN_MESSAGE_COUNT = sizeof(FOX_CAN_MESSAGES) / sizeof(FOX_CAN_MESSAGES[0]);
+
+constexpr FoxCANSignalDef FOX_CAN_SIGNALS[] = {
+    // Signal               CAN ID                   Start Len Order         Signed Scale Offset
+    { CANSIG_MODE_BYTE,     FOX_CAN_MODE_STATUS,      8,  8,  FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_RPM,           FOX_CAN_MODE_STATUS,      16, 16, FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_TEMP_CTRL,     FOX_CAN_MODE_STATUS,      32, 8,  FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_TEMP_MOTOR,    FOX_CAN_MODE_STATUS,      40, 8,  FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_SPEED,         FOX_CAN_TEMP_CTRL_MOT,    24, 8,  FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_BATT_TEMP_1,   FOX_CAN_TEMP_BATT_5S,     0,  8,  FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_BATT_TEMP_2,   FOX_CAN_TEMP_BATT_5S,     8,  8,  FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_BATT_TEMP_3,   FOX_CAN_TEMP_BATT_5S,     16, 8,  FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_BATT_TEMP_4,   FOX_CAN_TEMP_BATT_5S,     24, 8,  FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_BATT_TEMP_5,   FOX_CAN_TEMP_BATT_5S,     32, 8,  FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_BATT_TEMP_SGL, FOX_CAN_TEMP_BATT_SGL,    40, 8,  FOX_INTEL,    false, 1.0f, 0.0f },
+    { CANSIG_VOLTAGE,       FOX_CAN_VOLTAGE_CURRENT,  7,  16, FOX_MOTOROLA, false, 0.1f, 0.0f },
+    { CANSIG_CURRENT,       FOX_CAN_VOLTAGE_CURRENT,  23, 16, FOX_MOTOROLA, true,  0.1f, 0.0f },
+    { CANSIG_SOC_RAW,       FOX_CAN_SOC,              7,  16, FOX_MOTOROLA, false, 1.0f, 0.0f },
+};
+constexpr uint8_t FOX_CAN_SIGNAL_COUNT = sizeof(FOX_CAN_SIGNALS) / sizeof(FOX_CAN_SIGNALS[0]);
+
+// =============================================
+// VALIDASI TABEL (compile time)
+// =============================================
+namespace foxcandb {
+
+constexpr int messageIndex(uint32_t canId) {
+    for(int i = 0; i < FOX_CAN_MESSAGE_COUNT; i++) {
+        if(FOX_CAN_MESSAGES[i].canId == canId) return i;
+    }
+    return -1;
+}
+
+constexpr uint8_t firstByte(const FoxCANSignalDef& s) {
+    return s.startBit / 8;
+}
+
+constexpr uint8_t lastByte(const FoxCANSignalDef& s) {
+    if(s.order == FOX_INTEL) {
+        return (s.startBit + s.length - 1) / 8;
+    }
+    // Motorola: sisa bit setelah byte pertama mengalir ke byte berikutnya
+    int remaining = (int)s.length - (s.startBit % 8 + 1);
+    return s.startBit / 8 + (remaining > 0 ? (remaining + 7) / 8 : 0);
+}
+
+constexpr bool tableValid() {
+    for(int i = 0; i < FOX_CAN_SIGNAL_COUNT; i++) {
+        const FoxCANSignalDef& s = FOX_CAN_SIGNALS[i];
+        if(s.signal != i) return false;
+        if(s.length == 0 || s.length > 32) return false;
+        int m = messageIndex(s.canId);
+        if(m < 0) return false;
+        if(lastByte(s) >= FOX_CAN_MESSAGES[m].dlc || lastByte(s) >= 8) return false;
+    }
+    for(int i = 0; i < FOX_CAN_MESSAGE_COUNT; i++) {
+        if(messageIndex(FOX_CAN_MESSAGES[i].canId) != i) return false;  // ID duplikat
+    }
+    return true;
+}
+
+} // namespace foxcandb
+
+static_assert(FOX_CAN_SIGNAL_COUNT == CANSIG_COUNT, "FOX_CAN_SIGNALS tidak sesuai enum FoxCANSignal");
+static_assert(foxcandb::tableValid(), "FOX_CAN_SIGNALS / FOX_CAN_MESSAGES tidak valid");
+
+// =============================================
+// DECODER TERSPESIALISASI PER SIGNAL
+// =============================================
+// Semua posisi byte, shift, mask dan sign extension adalah konstanta
+// compile-time, jadi tiap decoder hanya berupa beberapa load + shift.
+template<size_t I>
+struct FoxSignalDecoder {
+    static constexpr FoxCANSignalDef def = FOX_CAN_SIGNALS[I];
+    static constexpr uint8_t first = foxcandb::firstByte(def);
+    static constexpr uint8_t nbytes = foxcandb::lastByte(def) - first + 1;
+    static constexpr uint8_t lsbPos = (def.order == FOX_INTEL)
+        ? def.startBit % 8
+        : (8 * (nbytes - 1) + def.startBit % 8) - (def.length - 1);
+    static constexpr uint64_t mask = (1ULL << def.length) - 1;
+
+    template<size_t... K>
+    static inline uint64_t load(const uint8_t* data, std::index_sequence<K...>) {
+        if constexpr (def.order == FOX_INTEL) {
+            return (0 | ... | ((uint64_t)data[first + K] << (8 * K)));
+        } else {
+            return (0 | ... | ((uint64_t)data[first + K] << (8 * (nbytes - 1 - K))));
+        }
+    }
+
+    static inline uint32_t raw(const uint8_t* data) {
+        return (uint32_t)((load(data, std::make_index_sequence<nbytes>{}) >> lsbPos) & mask);
+    }
+
+    static inline float decode(const uint8_t* data) {
+        int32_t value;
+        if constexpr (def.isSigned) {
+            value = (int32_t)(raw(data) << (32 - def.length)) >> (32 - def.length);
+        } else {
+            value = (int32_t)raw(data);
+        }
+        return value * def.scale + def.offset;
+    }
+};
+
+// Decoder per message: hanya signal milik CAN ID tersebut yang di-expand
+typedef void (*FoxCANDecodeFn)(const uint8_t* data, float* out);
+
+template<uint32_t CanId, size_t I>
+inline void foxDecodeIfMember(const uint8_t* data, float* out) {
+    if constexpr (FOX_CAN_SIGNALS[I].canId == CanId) {
+        out[I] = FoxSignalDecoder<I>::decode(data);
+    }
+}
+
+template<uint32_t CanId, size_t... I>
+inline void foxDecodeSignals(const uint8_t* data, float* out, std::index_sequence<I...>) {
+    (foxDecodeIfMember<CanId, I>(data, out), ...);
+}
+
+template<size_t M>
+void foxDecodeMessage(const uint8_t* data, float* out) {
+    foxDecodeSignals<FOX_CAN_MESSAGES[M].canId>(data, out, std::make_index_sequence<FOX_CAN_SIGNAL_COUNT>{});
+}
+
+// =============================================
+// DISPATCH CAN ID -> DECODER (dibangun saat compile)
+// =============================================
+struct FoxCANDispatchEntry {
+    uint32_t canId;
+    uint8_t message;    // Index ke FOX_CAN_MESSAGES / FOX_CAN_DECODERS
+};
+
+namespace foxcandb {
+
+template<size_t... M>
+constexpr std::array<FoxCANDecodeFn, sizeof...(M)> makeDecoders(std::index_sequence<M...>) {
+    return {{ &foxDecodeMessage<M>... }};
+}
+
+constexpr std::array<FoxCANDispatchEntry, FOX_CAN_MESSAGE_COUNT> makeDispatch() {
+    std::array<FoxCANDispatchEntry, FOX_CAN_MESSAGE_COUNT> table{};
+    for(uint8_t i = 0; i < FOX_CAN_MESSAGE_COUNT; i++) {
+        table[i] = { FOX_CAN_MESSAGES[i].canId, i };
+    }
+    // Insertion sort berdasarkan CAN ID untuk binary search
+    for(uint8_t i = 1; i < FOX_CAN_MESSAGE_COUNT; i++) {
+        FoxCANDispatchEntry key = table[i];
+        int j = i - 1;
+        while(j >= 0 && table[j].canId > key.canId) {
+            table[j + 1] = table[j];
+            j--;
+        }
+        table[j + 1] = key;
+    }
+    return table;
+}
+
+} // namespace foxcandb
+
+constexpr auto FOX_CAN_DECODERS = foxcandb::makeDecoders(std::make_index_sequence<FOX_CAN_MESSAGE_COUNT>{});
+constexpr auto FOX_CAN_DISPATCH = foxcandb::makeDispatch();
+
+// Fungsi: Index message untuk CAN ID, -1 jika tidak dikenal
+inline int8_t foxCANFindMessage(uint32_t canId) {
+    int lo = 0;
+    int hi = FOX_CAN_MESSAGE_COUNT - 1;
+    while(lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        uint32_t midId = FOX_CAN_DISPATCH[mid].canId;
+        if(midId == canId) return FOX_CAN_DISPATCH[mid].message;
+        if(midId < canId) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+#endif
@@ -0,0 +1,466 @@
+#include "fox_canlog.h"
+#include "fox_config.h"
+#include "fox_candb.h"
+#include <Arduino.h>
+
+#ifdef ESP32
+#include <FS.h>
+#include <LittleFS.h>
+#endif
+
+// ========== FORMAT BINER ==========
+// File  : CANLOG_DIR/segNN.bin, append-only, CANLOG_SEGMENT_BLOCKS blok
+// Blok  : header 12 byte + record, selalu CANLOG_BLOCK_SIZE byte
+// Record: [delta ms, varint LEB128][idx:4 | dlc:4][ID 4 byte LE jika idx = 15][payload]
+//         delta dari timestamp RX frame (bukan waktu kuras loop), sisa us dibawa ke record berikutnya
+//         idx 0..14 = index di FOX_CAN_MESSAGES, 15 = ID lain (ID lengkap ikut)
+// Delta dihitung dari record sebelumnya dalam blok yang sama,
+// record pertama relatif ke baseMs sehingga tiap blok bisa dibaca sendiri.
+#define CANLOG_MAGIC 0x4C46     // "FL"
+#define CANLOG_IDX_ESCAPE 15
+
+struct CANLogBlockHeader {
+    uint16_t magic;
+    uint16_t used;      // Byte record yang terisi
+    uint32_t seq;       // Nomor urut blok, naik terus lintas segment
+    uint32_t baseMs;    // millis() untuk delta record pertama
+};
+
+#define CANLOG_PAYLOAD_SIZE (CANLOG_BLOCK_SIZE - sizeof(CANLogBlockHeader))
+
+struct CANLogBlock {
+    CANLogBlockHeader hdr;
+    uint8_t payload[CANLOG_PAYLOAD_SIZE];
+};
+
+static_assert(sizeof(CANLogBlock) == CANLOG_BLOCK_SIZE, "Ukuran CANLogBlock harus satu halaman");
+
+bool canLogRecording = false;
+uint32_t canLogFramesRecorded = 0;
+uint32_t canLogFramesDropped = 0;
+volatile uint32_t canLogBlocksWritten = 0;
+volatile uint32_t canLogWriteErrors = 0;
+
+#ifdef ESP32
+// Pool blok: loop() mengisi blok, task writer menulis ke flash.
+// freeQueue / fullQueue berisi pointer blok sehingga decode path tidak pernah menunggu flash.
+CANLogBlock canLogPool[CANLOG_POOL_BLOCKS];
+QueueHandle_t canLogFreeQueue = NULL;
+QueueHandle_t canLogFullQueue = NULL;
+SemaphoreHandle_t canLogFileMutex = NULL;
+TaskHandle_t canLogTaskHandle = NULL;
+bool canLogFsReady = false;
+
+// Blok yang sedang diisi (hanya diakses dari loop)
+CANLogBlock* canLogCurrent = NULL;
+uint32_t canLogLastUs = 0;     // Timestamp RX record terakhir, dikurangi sisa < 1 ms
+uint32_t canLogNextSeq = 0;
+
+// State writer (hanya diakses task writer / saat mutex dipegang)
+File canLogFile;
+uint8_t canLogSegment = 0;
+uint16_t canLogSegmentBlocks = 0;
+
+static void segmentPath(uint8_t segment, char* path, size_t size) {
+    snprintf(path, size, CANLOG_DIR "/seg%02u.bin", segment);
+}
+
+// Fungsi: Baca header blok pertama sebuah segment, false jika kosong/rusak
+static bool readSegmentHeader(uint8_t segment, CANLogBlockHeader& hdr, uint32_t& blocks) {
+    char path[32];
+    segmentPath(segment, path, sizeof(path));
+    if(!LittleFS.exists(path)) return false;
+
+    File f = LittleFS.open(path, "r");
+    if(!f) return false;
+    blocks = f.size() / CANLOG_BLOCK_SIZE;
+    bool ok = blocks > 0 && f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) && hdr.magic == CANLOG_MAGIC;
+    f.close();
+    return ok;
+}
+
+// Fungsi: Cari segment terbaru, lanjutkan nomor urut blok setelahnya
+static void scanSegments() {
+    bool found = false;
+    uint32_t maxSeq = 0;
+    uint8_t newest = 0;
+
+    for(uint8_t i = 0; i < CANLOG_SEGMENTS; i++) {
+        CANLogBlockHeader hdr;
+        uint32_t blocks;
+        if(!readSegmentHeader(i, hdr, blocks)) continue;
+        uint32_t lastSeq = hdr.seq + blocks - 1;
+        if(!found || lastSeq > maxSeq) {
+            maxSeq = lastSeq;
+            newest = i;
+            found = true;
+        }
+    }
+
+    // Selalu mulai segment baru setelah yang terbaru:
+    // segment dianggap penuh sehingga tulisan pertama pindah ke segment berikutnya
+    canLogSegment = found ? newest : CANLOG_SEGMENTS - 1;
+    canLogSegmentBlocks = CANLOG_SEGMENT_BLOCKS;
+    canLogNextSeq = found ? maxSeq + 1 : 0;
+}
+
+// Fungsi: Tulis satu blok penuh ke ring segment (dipanggil task writer)
+static void writeBlock(const CANLogBlock* block) {
+    xSemaphoreTake(canLogFileMutex, portMAX_DELAY);
+
+    char path[32];
+    if(canLogSegmentBlocks >= CANLOG_SEGMENT_BLOCKS) {
+        if(canLogFile) canLogFile.close();
+        canLogSegment = (canLogSegment + 1) % CANLOG_SEGMENTS;
+        canLogSegmentBlocks = 0;
+        segmentPath(canLogSegment, path, sizeof(path));
+        canLogFile = LittleFS.open(path, "w");     // Truncate segment tertua
+    } else if(!canLogFile) {
+        // File ditutup oleh DUMP/CLEAR, lanjutkan segment yang sama
+        segmentPath(canLogSegment, path, sizeof(path));
+        canLogFile = LittleFS.open(path, canLogSegmentBlocks == 0 ? "w" : "a");
+    }
+
+    if(canLogFile && canLogFile.write((const uint8_t*)block, CANLOG_BLOCK_SIZE) == CANLOG_BLOCK_SIZE) {
+        canLogFile.flush();
+        canLogSegmentBlocks++;
+        canLogBlocksWritten++;
+    } else {
+        canLogWriteErrors++;
+    }
+
+    xSemaphoreGive(canLogFileMutex);
+}
+
+static void canLogTask(void* arg) {
+    CANLogBlock* block;
+    for(;;) {
+        if(xQueueReceive(canLogFullQueue, &block, portMAX_DELAY) == pdTRUE) {
+            writeBlock(block);
+            xQueueSend(canLogFreeQueue, &block, 0);
+        }
+    }
+}
+
+// Fungsi: Kirim blok yang sedang diisi ke writer
+static void submitCurrentBlock() {
+    if(canLogCurrent == NULL) return;
+    if(canLogCurrent->hdr.used > 0) {
+        xQueueSend(canLogFullQueue, &canLogCurrent, 0);     // Tidak pernah penuh: kapasitas = pool
+    } else {
+        xQueueSend(canLogFreeQueue, &canLogCurrent, 0);
+    }
+    canLogCurrent = NULL;
+}
+
+// Fungsi: Ambil blok kosong dari pool tanpa menunggu
+static bool openNewBlock(uint32_t timestampUs) {
+    if(xQueueReceive(canLogFreeQueue, &canLogCurrent, 0) != pdTRUE) {
+        canLogCurrent = NULL;
+        return false;
+    }
+    canLogCurrent->hdr.magic = CANLOG_MAGIC;
+    canLogCurrent->hdr.used = 0;
+    canLogCurrent->hdr.seq = canLogNextSeq++;
+    // Timestamp RX dipetakan ke domain millis()
+    canLogCurrent->hdr.baseMs = millis() - (uint32_t)(micros() - timestampUs) / 1000;
+    canLogLastUs = timestampUs;
+    return true;
+}
+#endif
+
+bool foxCANLogInit() {
+#ifdef ESP32
+    if(!LittleFS.begin(true)) {
+        Serial.println("CAN log: LittleFS gagal mount");
+        return false;
+    }
+    if(!LittleFS.exists(CANLOG_DIR)) {
+        LittleFS.mkdir(CANLOG_DIR);
+    }
+
+    canLogFreeQueue = xQueueCreate(CANLOG_POOL_BLOCKS, sizeof(CANLogBlock*));
+    canLogFullQueue = xQueueCreate(CANLOG_POOL_BLOCKS, sizeof(CANLogBlock*));
+    canLogFileMutex = xSemaphoreCreateMutex();
+    if(canLogFreeQueue == NULL || canLogFullQueue == NULL || canLogFileMutex == NULL) {
+        Serial.println("CAN log: gagal alokasi queue");
+        return false;
+    }
+    for(uint8_t i = 0; i < CANLOG_POOL_BLOCKS; i++) {
+        CANLogBlock* block = &canLogPool[i];
+        xQueueSend(canLogFreeQueue, &block, 0);
+    }
+
+    if(xTaskCreatePinnedToCore(canLogTask, "canLog", CANLOG_TASK_STACK, NULL,
+                               CANLOG_TASK_PRIORITY, &canLogTaskHandle,
+                               CANLOG_TASK_CORE) != pdPASS) {
+        Serial.println("CAN log: gagal membuat task writer");
+        return false;
+    }
+
+    canLogFsReady = true;
+    Serial.println("CAN log siap");
+    return true;
+#else
+    return false;
+#endif
+}
+
+void foxCANLogStart() {
+#ifdef ESP32
+    if(!canLogFsReady) {
+        Serial.println("CAN log: LittleFS tidak siap");
+        return;
+    }
+    if(canLogRecording) return;
+
+    xSemaphoreTake(canLogFileMutex, portMAX_DELAY);
+    if(canLogFile) canLogFile.close();
+    scanSegments();
+    xSemaphoreGive(canLogFileMutex);
+
+    canLogRecording = true;
+    Serial.print("CAN log started, segment ");
+    Serial.println(canLogSegment);
+#else
+    Serial.println("CAN log hanya untuk ESP32");
+#endif
+}
+
+void foxCANLogStop() {
+#ifdef ESP32
+    if(!canLogRecording) return;
+    canLogRecording = false;
+    submitCurrentBlock();
+    Serial.println("CAN log stopped");
+#endif
+}
+
+// Kirim blok parsial ke writer supaya data tidak tertahan lama di RAM
+void foxCANLogUpdate() {
+#ifdef ESP32
+    if(canLogRecording && canLogCurrent != NULL &&
+       millis() - canLogCurrent->hdr.baseMs > CANLOG_FLUSH_MS) {
+        submitCurrentBlock();
+    }
+#endif
+}
+
+// Dipanggil dari foxVehicleUpdateFromCAN(): hanya encode ke RAM, tidak ada akses flash.
+// timestampUs = micros() saat task RX mengambil frame dari driver.
+void foxCANLogRecord(uint32_t canId, const uint8_t* data, uint8_t len, uint32_t timestampUs) {
+#ifdef ESP32
+    if(!canLogRecording) return;
+    if(len > 8) len = 8;
+
+    // Body record: [idx:4 | dlc:4][ID jika escape][payload]
+    uint8_t body[1 + 4 + 8];
+    uint8_t bodyLen = 0;
+    int8_t m = foxCANFindMessage(canId);
+    uint8_t idx = (m >= 0 && m < CANLOG_IDX_ESCAPE) ? (uint8_t)m : CANLOG_IDX_ESCAPE;
+    body[bodyLen++] = (idx << 4) | len;
+    if(idx == CANLOG_IDX_ESCAPE) {
+        body[bodyLen++] = canId & 0xFF;
+        body[bodyLen++] = (canId >> 8) & 0xFF;
+        body[bodyLen++] = (canId >> 16) & 0xFF;
+        body[bodyLen++] = (canId >> 24) & 0xFF;
+    }
+    memcpy(&body[bodyLen], data, len);
+    bodyLen += len;
+
+    // Delta timestamp relatif ke record sebelumnya dalam blok
+    uint32_t delta = (canLogCurrent != NULL) ? (timestampUs - canLogLastUs) / 1000 : 0;
+    uint8_t varLen = 1;
+    for(uint32_t v = delta >> 7; v; v >>= 7) varLen++;
+
+    if(canLogCurrent != NULL && canLogCurrent->hdr.used + varLen + bodyLen > CANLOG_PAYLOAD_SIZE) {
+        submitCurrentBlock();
+    }
+    if(canLogCurrent == NULL) {
+        if(!openNewBlock(timestampUs)) {
+            canLogFramesDropped++;
+            return;
+        }
+        delta = 0;  // Record pertama relatif ke baseMs
+    }
+
+    canLogLastUs += delta * 1000;
+
+    uint8_t* out = &canLogCurrent->payload[canLogCurrent->hdr.used];
+    uint8_t n = 0;
+    do {
+        uint8_t b = delta & 0x7F;
+        delta >>= 7;
+        out[n++] = b | (delta ? 0x80 : 0);
+    } while(delta);
+    memcpy(&out[n], body, bodyLen);
+    canLogCurrent->hdr.used += n + bodyLen;
+    canLogFramesRecorded++;
+#endif
+}
+
+void foxCANLogDump() {
+#ifdef ESP32
+    if(canLogRecording) {
+        Serial.println("ERROR - LOG STOP dulu sebelum DUMP");
+        return;
+    }
+    if(!canLogFsReady) return;
+
+    // Tunggu writer selesai: setelah LOG STOP semua blok kembali ke free queue hanya setelah
+    // ditulis (antrian full kosong belum cukup, blok bisa sedang menunggu canLogFileMutex)
+    while(uxQueueMessagesWaiting(canLogFreeQueue) < CANLOG_POOL_BLOCKS) {
+        delay(5);
+    }
+
+    xSemaphoreTake(canLogFileMutex, portMAX_DELAY);
+    if(canLogFile) canLogFile.close();
+
+    // Urutkan segment berdasarkan nomor urut blok pertama
+    uint8_t order[CANLOG_SEGMENTS];
+    uint32_t firstSeq[CANLOG_SEGMENTS];
+    uint8_t count = 0;
+    for(uint8_t i = 0; i < CANLOG_SEGMENTS; i++) {
+        CANLogBlockHeader hdr;
+        uint32_t blocks;
+        if(!readSegmentHeader(i, hdr, blocks)) continue;
+        int j = count - 1;
+        while(j >= 0 && firstSeq[j] > hdr.seq) {
+            firstSeq[j + 1] = firstSeq[j];
+            order[j + 1] = order[j];
+            j--;
+        }
+        firstSeq[j + 1] = hdr.seq;
+        order[j + 1] = i;
+        count++;
+    }
+
+    // Format candump -L, bisa langsung dipakai replay harness
+    Serial.println("=== CAN LOG DUMP ===");
+    uint32_t frames = 0;
+    CANLogBlock block;
+    for(uint8_t s = 0; s < count; s++) {
+        char path[32];
+        segmentPath(order[s], path, sizeof(path));
+        File f = LittleFS.open(path, "r");
+        if(!f) continue;
+
+        while(f.read((uint8_t*)&block, CANLOG_BLOCK_SIZE) == CANLOG_BLOCK_SIZE) {
+            if(block.hdr.magic != CANLOG_MAGIC || block.hdr.used > CANLOG_PAYLOAD_SIZE) break;
+
+            uint32_t ts = block.hdr.baseMs;
+            uint16_t pos = 0;
+            while(pos < block.hdr.used) {
+                uint32_t delta = 0;
+                uint8_t shift = 0;
+                uint8_t b;
+                do {
+                    b = block.payload[pos++];
+                    delta |= (uint32_t)(b & 0x7F) << shift;
+                    shift += 7;
+                } while((b & 0x80) && pos < block.hdr.used && shift < 35);
+                ts += delta;
+
+                if(pos >= block.hdr.used) break;
+                uint8_t idxLen = block.payload[pos++];
+                uint8_t idx = idxLen >> 4;
+                uint8_t len = idxLen & 0x0F;
+                uint32_t canId;
+                if(idx == CANLOG_IDX_ESCAPE) {
+                    if(pos + 4 > block.hdr.used) break;
+                    canId = block.payload[pos] | (block.payload[pos + 1] << 8) |
+                            (block.payload[pos + 2] << 16) | ((uint32_t)block.payload[pos + 3] << 24);
+                    pos += 4;
+                } else if(idx < FOX_CAN_MESSAGE_COUNT) {
+                    canId = FOX_CAN_MESSAGES[idx].canId;
+                } else {
+                    break;
+                }
+                if(len > 8 || pos + len > block.hdr.used) break;
+
+                Serial.printf("(%lu.%03lu) can0 %08lX#", (unsigned long)(ts / 1000),
+                              (unsigned long)(ts % 1000), (unsigned long)canId);
+                for(uint8_t i = 0; i < len; i++) {
+                    Serial.printf("%02X", block.payload[pos + i]);
+                }
+                Serial.println();
+                pos += len;
+                frames++;
+            }
+        }
+        f.close();
+    }
+    xSemaphoreGive(canLogFileMutex);
+
+    Serial.print("=== END DUMP (");
+    Serial.print(frames);
+    Serial.println(" frames) ===");
+#else
+    Serial.println("CAN log hanya untuk ESP32");
+#endif
+}
+
+void foxCANLogClear() {
+#ifdef ESP32
+    if(canLogRecording) {
+        Serial.println("ERROR - LOG STOP dulu sebelum CLEAR");
+        return;
+    }
+    if(!canLogFsReady) return;
+
+    xSemaphoreTake(canLogFileMutex, portMAX_DELAY);
+    if(canLogFile) canLogFile.close();
+    for(uint8_t i = 0; i < CANLOG_SEGMENTS; i++) {
+        char path[32];
+        segmentPath(i, path, sizeof(path));
+        if(LittleFS.exists(path)) LittleFS.remove(path);
+    }
+    canLogSegment = CANLOG_SEGMENTS - 1;
+    canLogSegmentBlocks = CANLOG_SEGMENT_BLOCKS;
+    xSemaphoreGive(canLogFileMutex);
+    Serial.println("CAN log cleared");
+#endif
+}
+
+bool foxCANLogIsRecording() {
+    return canLogRecording;
+}
+
+FoxCANLogStats foxCANLogGetStats() {
+    FoxCANLogStats stats;
+    stats.recording = canLogRecording;
+    stats.framesRecorded = canLogFramesRecorded;
+    stats.framesDropped = canLogFramesDropped;
+    stats.blocksWritten = canLogBlocksWritten;
+    stats.writeErrors = canLogWriteErrors;
+    return stats;
+}
+
+void foxCANLogPrintStatus() {
+    FoxCANLogStats stats = foxCANLogGetStats();
+    Serial.println("=== CAN LOG ===");
+    Serial.print("Recording: ");
+    Serial.println(stats.recording ? "YES" : "NO");
+    Serial.print("Frames: ");
+    Serial.print(stats.framesRecorded);
+    Serial.print(" recorded, ");
+    Serial.print(stats.framesDropped);
+    Serial.println(" dropped");
+    Serial.print("Blocks written: ");
+    Serial.print(stats.blocksWritten);
+    Serial.print(" (");
+    Serial.print(stats.blocksWritten * CANLOG_BLOCK_SIZE / 1024);
+    Serial.println(" KB)");
+    Serial.print("Write errors: ");
+    Serial.println(stats.writeErrors);
+#ifdef ESP32
+    if(canLogFsReady) {
+        Serial.print("LittleFS: ");
+        Serial.print(LittleFS.usedBytes() / 1024);
+        Serial.print("/");
+        Serial.print(LittleFS.totalBytes() / 1024);
+        Serial.println(" KB");
+    }
+#endif
+    Serial.println("===============");
+}
@@ -0,0 +1,26 @@
+#ifndef FOX_CANLOG_H
+#define FOX_CANLOG_H
+
+#include <Arduino.h>
+
+// Statistik recorder
+struct FoxCANLogStats {
+    bool recording;
+    uint32_t framesRecorded;
+    uint32_t framesDropped;     // Pool blok RAM habis, frame tidak dicatat
+    uint32_t blocksWritten;
+    uint32_t writeErrors;
+};
+
+bool foxCANLogInit();
+void foxCANLogStart();
+void foxCANLogStop();
+void foxCANLogUpdate();
+void foxCANLogRecord(uint32_t canId, const uint8_t* data, uint8_t len, uint32_t timestampUs);
+void foxCANLogDump();
+void foxCANLogClear();
+bool foxCANLogIsRecording();
+FoxCANLogStats foxCANLogGetStats();
+void foxCANLogPrintStatus();
+
+#endif
@@ -13,18 +13,51 @@
 #define CAN_RX_PIN 21
 #define DEBOUNCE_DELAY 50
 
+// Serial Command Configuration (buffer tetap, tanpa String)
+#define SERIAL_COMMAND_MAX_LEN 48       // Karakter lebih dari ini dibuang
+#define SERIAL_COMMAND_TIMEOUT_MS 1000  // Command tanpa newline diproses setelah jeda ini
+
 // OLED Display Configuration
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 32
 #define OLED_ADDRESS 0x3C
+#define OLED_PARTIAL_FLUSH true     // Kirim hanya window kolom/page yang berubah
+#define OLED_I2C_CHUNK 32           // Byte data per transaksi I2C (buffer Wire ESP32 128)
+#define OLED_FLUSH_TASK_STACK 3072
+#define OLED_FLUSH_TASK_PRIORITY 2
+#define OLED_FLUSH_TASK_CORE 0      // Loop Arduino jalan di core 1
 
 // CAN Bus Configuration
 #define CAN_BAUDRATE 250000
 #define CAN_MODE 1  // TWAI_MODE_LISTEN_ONLY
 
+// CAN Receive Task Configuration
+#define CAN_RX_QUEUE_LEN 32         // Antrian RX driver TWAI (default driver hanya 5)
+#define CAN_RX_RING_SIZE 256        // Ring buffer task -> loop, harus pangkat 2
+#define CAN_RX_TASK_STACK 4096
+#define CAN_RX_TASK_PRIORITY 5
+#define CAN_RX_TASK_CORE 0          // Loop Arduino jalan di core 1
+#define CAN_RX_ALERT_TIMEOUT_MS 100 // Task RX bangun minimal 10x/detik untuk cek ganti filter
+#define CAN_DRIVER_RETRY_MS 2000    // Interval install ulang driver TWAI yang gagal
+
 // RTC Configuration
 #define RTC_I2C_ADDRESS 0x68
 
+// I2C Bus Manager (OLED + RTC di satu bus)
+#define I2C_CLOCK_START_HZ 100000       // Clock awal, naik bertahap selama bus bersih
+#define I2C_OLED_MAX_CLOCK_HZ 1000000   // SSD1306 resmi 400kHz, modul yang tidak kuat turun otomatis
+#define I2C_RTC_MAX_CLOCK_HZ 400000     // DS3231 fast mode
+#define I2C_TIMEOUT_MS 20
+#define I2C_ADAPT_WINDOW 64             // Transaksi per window evaluasi error
+#define I2C_ADAPT_MAX_ERRORS 2          // Error NACK/timeout dalam window -> clock turun 1 step
+#define I2C_ADAPT_CLEAN_WINDOWS 4       // Window bersih berturut-turut -> clock naik 1 step
+#define I2C_ADAPT_HOLD_MS 300000        // Clock yang gagal tidak dicoba lagi selama 5 menit
+#define I2C_RECOVERY_ERRORS 5           // Error transfer OLED berturut-turut -> recovery bus
+#define I2C_RECOVERY_SETTLE_MS 100      // Jeda stabilisasi pin antar langkah recovery
+#define I2C_RECOVERY_BACKOFF_MS 500     // Jeda setelah recovery gagal, dobel tiap kegagalan
+#define I2C_RECOVERY_BACKOFF_MAX_MS 30000
+#define I2C_RECOVERY_STABLE_MS 60000    // Bus sehat selama ini -> backoff kembali dari awal
+
 // =============================================
 // PAGE CONFIGURATION SYSTEM
 // =============================================
@@ -33,20 +66,14 @@
 #define PAGE_CLOCK_ENABLED     true    // Page 1: Clock
 #define PAGE_TEMP_ENABLED      true    // Page 2: Temperature  
 #define PAGE_ELECTRICAL_ENABLED false  // Page 3: Electrical (currently disabled)
+#define PAGE_TRIP_ENABLED      true    // Page 4: Trip computer
 // Page 9 (Sport) is always enabled for automatic mode switching
 
 // Maximum number of user pages (excluding sport page)
-#if PAGE_CLOCK_ENABLED && PAGE_TEMP_ENABLED && PAGE_ELECTRICAL_ENABLED
-  #define MAX_USER_PAGES 3
-#elif (PAGE_CLOCK_ENABLED && PAGE_TEMP_ENABLED) || \
-      (PAGE_CLOCK_ENABLED && PAGE_ELECTRICAL_ENABLED) || \
-      (PAGE_TEMP_ENABLED && PAGE_ELECTRICAL_ENABLED)
-  #define MAX_USER_PAGES 2
-#elif PAGE_CLOCK_ENABLED || PAGE_TEMP_ENABLED || PAGE_ELECTRICAL_ENABLED
-  #define MAX_USER_PAGES 1
-#else
-  #define MAX_USER_PAGES 0
-#endif
+#define MAX_USER_PAGES ((PAGE_CLOCK_ENABLED ? 1 : 0) + \
+                        (PAGE_TEMP_ENABLED ? 1 : 0) + \
+                        (PAGE_ELECTRICAL_ENABLED ? 1 : 0) + \
+                        (PAGE_TRIP_ENABLED ? 1 : 0))
 
 // =============================================
 // KONFIGURASI VEHICLE
@@ -70,26 +97,8 @@
 #define MODE_BYTE_REVERSE 0x50
 #define MODE_BYTE_NEUTRAL 0x40
 
-// Macro untuk deteksi semua charging modes
-#define IS_CHARGING_MODE(b) ((b) == MODE_BYTE_CHARGING_1 || \
-                             (b) == MODE_BYTE_CHARGING_2 || \
-                             (b) == MODE_BYTE_CHARGING_3 || \
-                             (b) == MODE_BYTE_CHARGING_4)
-
-// Macro untuk deteksi semua known modes
-#define IS_KNOWN_MODE(b) ((b) == MODE_BYTE_PARK || \
-                          (b) == MODE_BYTE_DRIVE || \
-                          (b) == MODE_BYTE_SPORT || \
-                          (b) == MODE_BYTE_CRUISE || \
-                          (b) == MODE_BYTE_SPORT_CRUISE || \
-                          (b) == MODE_BYTE_CUTOFF_1 || \
-                          (b) == MODE_BYTE_CUTOFF_2 || \
-                          (b) == MODE_BYTE_STANDBY_1 || \
-                          (b) == MODE_BYTE_STANDBY_2 || \
-                          (b) == MODE_BYTE_STANDBY_3 || \
-                          (b) == MODE_BYTE_REVERSE || \
-                          (b) == MODE_BYTE_NEUTRAL || \
-                          IS_CHARGING_MODE(b))
+// Byte di luar daftar ini diklasifikasi lewat tabel 256 entry di fox_vehicle.cpp
+// (safe fallback per pola byte) dan dicatat sebagai unknown mode byte.
 
 // Speed Configuration
 #define SPEED_TRIGGER_SPORT_PAGE 80  // Speed untuk trigger mode page sport (km/h)
@@ -106,9 +115,7 @@
 #define SPLASH_DURATION_MS 1500     // Durasi tulisan awal satuan ms atau milidetik
 
 // Page 1: Clock Configuration
-#define CLOCK_TIME_FORMAT "%02d:%02d"
-#define CLOCK_DATE_FORMAT "%d %s"
-#define CLOCK_YEAR_FORMAT "%04d"
+#define CLOCK_HOUR_LEADING_ZERO true  // true = "09:05", false = "9:05"
 
 // Page 2: Temperature Configuration
 #define TEMP_LABEL_ECU "ECU"       // Label tulisan di atas suhu controller
@@ -122,9 +129,17 @@
 #define KMH_TEXT "km/h"
 #define RPM_TEXT "rpm"
 
+// Page 4: Trip Configuration
+#define TRIP_LABEL_DIST "KM"       // Jarak trip
+#define TRIP_LABEL_WHKM "WH/KM"    // Konsumsi rata-rata trip
+#define TRIP_LABEL_RANGE "RANGE"   // Estimasi sisa jarak (km)
+
 // Charging Mode Configuration
 #define CHARGING_TEXT "CHARGING"
 
+// Tampilan signal stale (frame tidak datang lagi, lihat SIGNAL_TIMEOUT_*)
+#define STALE_TEXT "--"
+
 // Setup Mode Configuration
 #define SETUP_TEXT "SETUP"
 #define SETUP_TIMEOUT_MS 30000
@@ -144,6 +159,102 @@
 #define FOX_CAN_SOC           0x0A6E0D09UL  // Persentase baterai atau State of Charge (%)
 #define FOX_CAN_CURRENT       0x0A6F0D09UL  // Arus (Current)
 
+// Tegangan (byte 0-1) dan arus (byte 2-3) dikirim dalam satu frame
+#define FOX_CAN_VOLTAGE_CURRENT FOX_CAN_VOLTAGE
+
+// Whitelist, DLC dan layout signal tiap ID ada di fox_candb.h
+
+// CAN Decode Interval per ID (ms)
+// Frame terbaru per ID selalu disimpan di mailbox; decode dilakukan saat
+// data dibaca (foxVehicleGetData) dan interval ID tersebut sudah lewat.
+#define CAN_DECODE_INTERVAL_MODE_MS      10    // Mode + RPM + suhu ECU/motor
+#define CAN_DECODE_INTERVAL_SPEED_MS     10    // Speed
+#define CAN_DECODE_INTERVAL_BATT_TEMP_MS 500   // Suhu baterai (5S & single)
+#define CAN_DECODE_INTERVAL_VOLTAGE_MS   100   // Tegangan & arus
+#define CAN_DECODE_INTERVAL_SOC_MS       1000  // SOC
+#define CAN_DECODE_INTERVAL_CHARGING_MS  100   // Interval minimal semua ID saat charging
+
+// Timeout per signal: tanpa frame baru selama ini, signal ditandai stale (tampil "--")
+#define SIGNAL_TIMEOUT_MODE_MS        1000  // Mode, RPM
+#define SIGNAL_TIMEOUT_SPEED_MS       1000
+#define SIGNAL_TIMEOUT_TEMP_MS        5000  // Suhu ECU, motor, baterai
+#define SIGNAL_TIMEOUT_ELECTRICAL_MS  2000  // Tegangan & arus
+#define SIGNAL_TIMEOUT_SOC_MS         10000
+
+// =============================================
+// KONFIGURASI CAN LOGGER (LittleFS)
+// =============================================
+
+// Frame disimpan biner di ring CANLOG_SEGMENTS file x CANLOG_SEGMENT_BLOCKS blok.
+// Segment tertua ditimpa saat ring penuh.
+#define CANLOG_DIR "/canlog"
+#define CANLOG_BLOCK_SIZE 256           // Satu halaman flash
+#define CANLOG_SEGMENT_BLOCKS 64        // 16 KB per file segment
+#define CANLOG_SEGMENTS 16              // Total 256 KB
+#define CANLOG_POOL_BLOCKS 8            // Buffer RAM antara decode path dan task writer
+#define CANLOG_FLUSH_MS 2000            // Blok parsial dikirim ke writer setelah 2 detik
+#define CANLOG_TASK_STACK 4096
+#define CANLOG_TASK_PRIORITY 1
+#define CANLOG_TASK_CORE 0
+
+// =============================================
+// KONFIGURASI CAN SNIFFER (CAPTURE ON)
+// =============================================
+
+// Tabel hash open addressing per CAN ID, harus pangkat 2.
+// ID baru setelah tabel penuh hanya dihitung sebagai dropped.
+#define SNIFFER_TABLE_SIZE 64
+
+// Unknown mode byte (CLEARUNKNOWN): count & waktu pertama terlihat, disimpan di NVS
+#define UNKNOWN_MODE_MAX_RECORDS 32     // Byte baru setelah penuh hanya dihitung dropped
+#define UNKNOWN_MODE_SAVE_MS 60000      // Simpan count tiap 1 menit (byte baru langsung)
+
+// =============================================
+// KONFIGURASI TRIP COMPUTER
+// =============================================
+
+// Kapasitas pack untuk estimasi range (72V x 40Ah, sesuaikan dengan baterai)
+#define TRIP_PACK_CAPACITY_WH 2880
+#define TRIP_DEFAULT_WH_PER_KM 30.0f    // Konsumsi awal sebelum ada data rolling
+#define TRIP_ROLLING_SEGMENT_M 100      // Konsumsi rolling diperbarui tiap 100 m
+#define TRIP_ROLLING_ALPHA 0.1f         // EWMA per segment (~1 km terakhir)
+#define TRIP_MAX_GAP_MS 2000            // Gap frame lebih lama dari ini tidak diintegrasi
+#define TRIP_SAVE_INTERVAL_MS 300000    // Simpan ke NVS tiap 5 menit saat berubah
+#define TRIP_SAVE_STOP_MS 10000         // ... atau setelah berhenti 10 detik
+
+// =============================================
+// KONFIGURASI RIDING STATS
+// =============================================
+
+// Histogram waktu (16 bucket per channel) + estimator P2 p50/p95/p99, per mode kendaraan
+#define STATS_BUCKETS 16
+#define STATS_MAX_GAP_MS 2000           // Gap frame lebih lama dari ini tidak dihitung waktunya
+#define STATS_TEMP_ALERT_C 60           // Batas "waktu di atas suhu" di command STATS
+
+// =============================================
+// KONFIGURASI EVENT BUS
+// =============================================
+
+// Subscriber (display, log, stats) menerima event perubahan dari modul vehicle
+#define EVENT_MAX_SUBSCRIBERS 12
+#define EVENT_LOG_BMS_INTERVAL_MS 5000          // Log BMS V/I saat tidak charging
+#define EVENT_LOG_CHARGING_INTERVAL_MS 60000    // Log charging saat SOC berubah, maks 1x/menit
+#define EVENT_LOG_TEMP_ALERT_C 70               // Log saat suhu controller/motor lewat batas
+#define EVENT_LOG_TEMP_HYST_C 5
+
+// =============================================
+// KONFIGURASI HISTORY SIGNAL (RAM)
+// =============================================
+
+// Tier 0 = sample mentah, tier berikutnya = min/max/mean dari tier sebelumnya.
+// 8 channel x 1 byte: T0 4.8 KB + T1 21.6 KB + T2 6.9 KB = ~33 KB SRAM
+#define HISTORY_T0_PERIOD_MS 100        // 10 Hz
+#define HISTORY_T0_LEN 600              // 60 detik terakhir
+#define HISTORY_T1_FACTOR 10            // 10 sample T0 = 1 detik
+#define HISTORY_T1_LEN 900              // 15 menit terakhir
+#define HISTORY_T2_FACTOR 300           // 300 bucket T1 = 5 menit
+#define HISTORY_T2_LEN 288              // 24 jam terakhir
+
 // =============================================
 // KONFIGURASI TAMPILAN
 // =============================================
@@ -152,13 +263,14 @@
 #define FONT_SIZE_SMALL 1
 #define FONT_SIZE_MEDIUM 2
 #define FONT_SIZE_LARGE 3
+#define GLYPH_CACHE_ENABLED true   // Digit jam & speed di-blit dari cache (lihat fox_display.cpp)
 
 // Timing Configuration
-#define UPDATE_INTERVAL_NORMAL_MS 1000
-#define UPDATE_INTERVAL_ELECTRICAL_MS 500   // Update lebih cepat untuk page electrical
-#define UPDATE_INTERVAL_SPORT_MS 10
+// Page dirender saat content key berubah (lihat render scheduler di fox_display.cpp)
+#define DISPLAY_MAX_FPS 30                  // Batas render, juga untuk page sport
+#define DISPLAY_MIN_REFRESH_MS 10000        // Watchdog: render + flush penuh minimal tiap 10 detik
+#define DISPLAY_CLOCK_SAMPLE_MS 1000        // RTC dibaca maksimal 1x/detik untuk content key
 #define UPDATE_INTERVAL_SETUP_MS 500
-#define UPDATE_INTERVAL_CHARGING_MS 5000    // Update lambat saat charging
 #define DEBUG_INTERVAL_MS 10000
 #define BLINK_INTERVAL_MS 500
 
@@ -196,7 +308,9 @@ enum DisplayPage {
     PAGE_CLOCK = 1,      // User page 1: Jam & Tanggal
     PAGE_TEMP = 2,       // User page 2: Suhu
     PAGE_ELECTRICAL = 3, // User page 3: Voltage & Current
-    PAGE_SPORT = 9       // Hidden page: Sport Mode (auto-trigger only)
+    PAGE_TRIP = 4,       // User page 4: Trip computer
+    PAGE_SPORT = 9,      // Hidden page: Sport Mode (auto-trigger only)
+    PAGE_CHARGING = 99   // Hidden page: layar charging sederhana
 };
 
 #endif
@@ -5,23 +5,79 @@
 #include "fox_config.h"
 #include "fox_rtc.h"
 #include "fox_vehicle.h"
+#include "fox_trip.h"
+#include "fox_i2c.h"
+#include "fox_format.h"
 #include <Fonts/FreeSansBold18pt7b.h>
 
 // Deklarasi global
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
 bool displayInitialized = false;
 
-// Variabel untuk tracking perubahan
-uint8_t lastDisplayedSpeed = 0;
-uint16_t lastDisplayedRPM = 0;
-bool sportNeedsUpdate = false;
-unsigned long lastBlinkTime = 0;
+// Render scheduler (lihat foxDisplayUpdate)
+bool renderForced = true;               // Render berikutnya tidak boleh di-skip (layar diganti di luar scheduler)
 bool blinkState = true;
 
-// I2C error tracking
-int i2cErrorCount = 0;
-unsigned long lastI2CErrorTime = 0;
-unsigned long lastI2CCheck = 0;
+// Partial flush: isi GDDRAM OLED setelah flush terakhir (milik task flush / pemegang bus)
+#define OLED_PAGES (SCREEN_HEIGHT / 8)
+#define OLED_BUFFER_SIZE (SCREEN_WIDTH * OLED_PAGES)
+uint8_t oledShadow[OLED_BUFFER_SIZE];
+volatile bool oledShadowValid = false;  // false = flush berikutnya penuh
+
+// Async flush: loop -> oledPending -> task (oledFront) -> I2C
+uint8_t oledPending[OLED_BUFFER_SIZE];
+uint8_t oledFront[OLED_BUFFER_SIZE];
+bool oledPendingReady = false;
+bool oledPendingFull = false;           // Flush penuh diminta (watchdog), ikut frame pending
+volatile bool oledFlushFailed = false;  // Flush terakhir gagal, scheduler mengirim ulang frame penuh
+volatile uint32_t oledFramesFlushed = 0;
+volatile uint32_t oledFramesSuperseded = 0;
+#ifdef ESP32
+portMUX_TYPE oledPendingMux = portMUX_INITIALIZER_UNLOCKED;
+SemaphoreHandle_t oledBusMutex = NULL;
+TaskHandle_t oledFlushTaskHandle = NULL;
+#endif
+
+// ========== INSTRUMENTASI ==========
+// Timing ditulis loop (render, handoff, health) dan task flush (flush), dibaca DISPSTATS
+static const uint32_t displayTimeBounds[DISPLAY_TIME_BUCKETS - 1] = {100, 200, 500, 1000, 2000, 5000, 10000};
+FoxDisplayTiming timingRender;
+FoxDisplayTiming timingHandoff;
+FoxDisplayTiming timingFlush;
+FoxDisplayTiming timingHealth;
+FoxDisplayPageStats pageStats[DISPLAY_STATS_PAGES];    // Hanya ditulis loop
+unsigned long statsLastUpdateMs = 0;
+#ifdef ESP32
+portMUX_TYPE displayStatsMux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+static void recordTiming(FoxDisplayTiming& timing, uint32_t us) {
+    uint8_t bucket = 0;
+    while(bucket < DISPLAY_TIME_BUCKETS - 1 && us >= displayTimeBounds[bucket]) bucket++;
+    
+#ifdef ESP32
+    portENTER_CRITICAL(&displayStatsMux);
+#endif
+    timing.count++;
+    timing.totalUs += us;
+    if(us > timing.maxUs) timing.maxUs = us;
+    timing.histogram[bucket]++;
+#ifdef ESP32
+    portEXIT_CRITICAL(&displayStatsMux);
+#endif
+}
+
+static uint8_t statsPageSlot(int page) {
+    switch(page) {
+        case PAGE_CLOCK: return DISPLAY_STATS_CLOCK;
+        case PAGE_TEMP: return DISPLAY_STATS_TEMP;
+        case PAGE_ELECTRICAL: return DISPLAY_STATS_ELECTRICAL;
+        case PAGE_TRIP: return DISPLAY_STATS_TRIP;
+        case PAGE_SPORT: return DISPLAY_STATS_SPORT;
+        case PAGE_CHARGING: return DISPLAY_STATS_CHARGING;
+        default: return DISPLAY_STATS_OTHER;
+    }
+}
 
 // Helper function
 void showPageDisabled(int page) {
@@ -32,148 +88,497 @@ void showPageDisabled(int page) {
     display.print(" DISABLED");
 }
 
-// Fungsi I2C recovery
-void recoverI2C() {
-    Serial.println("=== I2C RECOVERY START ===");
-    
-    // Stop I2C
-    Wire.end();
-    
-    // Reset pins ke high-impedance
-    pinMode(SDA_PIN, INPUT);
-    pinMode(SCL_PIN, INPUT);
-    delay(100); // Delay lebih lama untuk stabilisasi
-    
-    // Generate clock pulses untuk clear stuck devices
-    pinMode(SCL_PIN, OUTPUT);
-    Serial.print("Sending clock pulses...");
-    for(int i = 0; i < 20; i++) {
-        digitalWrite(SCL_PIN, LOW);
-        delayMicroseconds(10);
-        digitalWrite(SCL_PIN, HIGH);
-        delayMicroseconds(10);
-    }
-    Serial.println("Done");
-    
-    // Reinitialize dengan pull-up
-    pinMode(SDA_PIN, INPUT_PULLUP);
-    pinMode(SCL_PIN, INPUT_PULLUP);
-    delay(100);
+// ========== GLYPH CACHE ==========
+// Digit jam (FreeSansBold18pt7b) dan speed (font klasik size 3) dirasterisasi sekali
+// oleh Adafruit_GFX ke canvas saat init, lalu disimpan per kolom dalam format page
+// SSD1306 pada posisi y yang dipakai page. Menggambar angka = OR byte ke framebuffer.
+#define GLYPH_MAX_CHARS 12
+#define GLYPH_MAX_WIDTH 24
+#define GLYPH_CAPTURE_X 16          // Margin kiri, glyph dengan xOffset negatif tidak terpotong
+#define CLOCK_CURSOR_Y 28
+#define SPEED_CURSOR_Y 10
+
+struct CachedGlyph {
+    int8_t colOffset;               // Kolom pertama relatif ke cursor x
+    uint8_t width;                  // Jumlah kolom berisi pixel (0 = spasi)
+    uint8_t advance;                // Pergeseran cursor x
+    uint8_t columns[OLED_PAGES][GLYPH_MAX_WIDTH];
+};
+
+struct GlyphCache {
+    const GFXfont* font;            // NULL = font klasik
+    uint8_t textSize;
+    int16_t cursorY;                // Posisi y capture = posisi y saat blit
+    const char* chars;
+    bool ready;
+    CachedGlyph glyphs[GLYPH_MAX_CHARS];
+};
+
+GlyphCache clockGlyphs = {&FreeSansBold18pt7b, FONT_SIZE_SMALL, CLOCK_CURSOR_Y, "0123456789:"};
+GlyphCache speedGlyphs = {NULL, FONT_SIZE_LARGE, SPEED_CURSOR_Y, "0123456789 -"};
+bool glyphCacheActive = true;       // false = selalu lewat Adafruit_GFX (perbandingan di renderer host)
+
+static bool buildGlyphCache(GlyphCache& cache) {
+    GFXcanvas1 canvas(SCREEN_WIDTH, SCREEN_HEIGHT);
+    if(canvas.getBuffer() == NULL) return false;
+    canvas.setFont(cache.font);
+    canvas.setTextSize(cache.textSize);
+    canvas.setTextWrap(false);
     
-    Wire.begin(SDA_PIN, SCL_PIN);
+    uint8_t count = strlen(cache.chars);
+    if(count > GLYPH_MAX_CHARS) return false;
     
-    // Gunakan speed lebih rendah jika charging
-    FoxVehicleData data = foxVehicleGetData();
-    if(data.mode == MODE_CHARGING) {
-        Wire.setClock(50000); // 50kHz saat charging
+    for(uint8_t i = 0; i < count; i++) {
+        CachedGlyph& glyph = cache.glyphs[i];
+        memset(&glyph, 0, sizeof(glyph));
+        canvas.fillScreen(0);
+        canvas.setCursor(GLYPH_CAPTURE_X, cache.cursorY);
+        canvas.write(cache.chars[i]);
+        glyph.advance = canvas.getCursorX() - GLYPH_CAPTURE_X;
+        
+        int first = -1;
+        int last = -1;
+        for(int x = 0; x < SCREEN_WIDTH; x++) {
+            for(int y = 0; y < SCREEN_HEIGHT; y++) {
+                if(canvas.getPixel(x, y)) {
+                    if(first < 0) first = x;
+                    last = x;
+                    break;
+                }
+            }
+        }
+        if(first < 0) continue;     // Spasi
+        if(last - first + 1 > GLYPH_MAX_WIDTH) return false;
+        
+        glyph.colOffset = first - GLYPH_CAPTURE_X;
+        glyph.width = last - first + 1;
+        for(uint8_t col = 0; col < glyph.width; col++) {
+            for(int y = 0; y < SCREEN_HEIGHT; y++) {
+                if(canvas.getPixel(first + col, y)) {
+                    glyph.columns[y / 8][col] |= 1 << (y & 7);
+                }
+            }
+        }
+    }
+    cache.ready = true;
+    return true;
+}
+
+// Return false jika cache belum siap atau ada karakter di luar cache
+static bool blitGlyphs(const GlyphCache& cache, int16_t x, const char* text) {
+    if(!cache.ready) return false;
+    for(const char* p = text; *p; p++) {
+        if(strchr(cache.chars, *p) == NULL) return false;
+    }
+    
+    uint8_t* buffer = display.getBuffer();
+    for(const char* p = text; *p; p++) {
+        const CachedGlyph& glyph = cache.glyphs[strchr(cache.chars, *p) - cache.chars];
+        int16_t col = x + glyph.colOffset;
+        for(uint8_t c = 0; c < glyph.width; c++, col++) {
+            if(col < 0 || col >= SCREEN_WIDTH) continue;
+            for(uint8_t page = 0; page < OLED_PAGES; page++) {
+                buffer[page * SCREEN_WIDTH + col] |= glyph.columns[page][c];
+            }
+        }
+        x += glyph.advance;
+    }
+    display.setCursor(x, cache.cursorY);
+    return true;
+}
+
+// Fungsi: Tulis teks dari cache, fallback ke Adafruit_GFX (hasil pixel sama)
+static void printCached(const GlyphCache& cache, int16_t x, const char* text) {
+    if(glyphCacheActive && blitGlyphs(cache, x, text)) return;
+    display.setFont(cache.font);
+    display.setTextSize(cache.textSize);
+    display.setCursor(x, cache.cursorY);
+    display.print(text);
+}
+
+static void initGlyphCache() {
+#if GLYPH_CACHE_ENABLED
+    unsigned long start = micros();
+    bool ok = buildGlyphCache(clockGlyphs) && buildGlyphCache(speedGlyphs);
+    Serial.print("Glyph cache: ");
+    if(ok) {
+        Serial.print(micros() - start);
+        Serial.println(" us");
     } else {
-        Wire.setClock(100000); // 100kHz normal
+        Serial.println("gagal, pakai Adafruit_GFX");
     }
+#endif
+}
+
+// ========== PARTIAL FLUSH ==========
+// Kirim satu window (1 page, kolom col0..col1): COLUMNADDR/PAGEADDR dalam satu
+// transaksi command, lalu data per OLED_I2C_CHUNK byte. Chunk data dikirim prioritas
+// BULK, jadi baca RTC bisa menyela di antara chunk.
+static bool oledSendWindow(uint8_t page, uint8_t col0, uint8_t col1, const uint8_t* row) {
+    const uint8_t window[] = {
+        SSD1306_COLUMNADDR, col0, col1,
+        SSD1306_PAGEADDR, page, page
+    };
+    // Co = 0, D/C = 0: command stream
+    if(foxI2CWrite(I2C_DEV_OLED, I2C_PRIO_NORMAL, 0x00, window, sizeof(window)) != I2C_OK) return false;
     
-    // Test koneksi
-    byte error;
-    bool oledFound = false;
-    uint8_t oledAddresses[] = {0x3C, 0x3D};
+    int col = col0;
+    while(col <= col1) {
+        int len = col1 - col + 1;
+        if(len > OLED_I2C_CHUNK) len = OLED_I2C_CHUNK;
+        // Data stream
+        if(foxI2CWrite(I2C_DEV_OLED, I2C_PRIO_BULK, 0x40, row + col, len) != I2C_OK) return false;
+        col += len;
+    }
+    return true;
+}
+
+// Fungsi: Kirim frame ke OLED. Per page (8 baris pixel) hanya rentang kolom yang
+// berbeda dari frame terakhir yang dikirim; frame tanpa perubahan tidak memakai bus.
+static void oledSendFrame(const uint8_t* frame, bool forceFull) {
+    uint32_t start = micros();
+    bool full = !OLED_PARTIAL_FLUSH || !oledShadowValid || forceFull;
+    bool ok = true;
     
-    for(int i = 0; i < 2; i++) {
-        Wire.beginTransmission(oledAddresses[i]);
-        error = Wire.endTransmission();
+    for(uint8_t page = 0; page < OLED_PAGES; page++) {
+        const uint8_t* row = frame + page * SCREEN_WIDTH;
+        uint8_t* shadow = oledShadow + page * SCREEN_WIDTH;
         
-        if(error == 0) {
-            Serial.print("OLED found at 0x");
-            Serial.println(oledAddresses[i], HEX);
-            
-            // Reinitialize display
-            if(display.begin(SSD1306_SWITCHCAPVCC, oledAddresses[i])) {
-                displayInitialized = true;
-                oledFound = true;
-                Serial.println("OLED reinitialized successfully");
-                break;
-            }
+        int first = 0;
+        int last = SCREEN_WIDTH - 1;
+        if(!full) {
+            while(first < SCREEN_WIDTH && row[first] == shadow[first]) first++;
+            if(first == SCREEN_WIDTH) continue;
+            while(row[last] == shadow[last]) last--;
+        }
+        
+        if(!oledSendWindow(page, first, last, row)) {
+            ok = false;
+            break;
         }
+        memcpy(shadow + first, row + first, last - first + 1);
     }
     
-    if(!oledFound) {
-        Serial.println("OLED NOT FOUND after recovery");
-        displayInitialized = false;
+    if(ok) {
+        oledShadowValid = true;
+        oledFramesFlushed++;
+    } else {
+        // Isi GDDRAM tidak pasti, frame berikutnya flush penuh
+        oledShadowValid = false;
+        oledFlushFailed = true;
     }
-    
-    Serial.println("=== I2C RECOVERY END ===");
+    recordTiming(timingFlush, micros() - start);
 }
 
-// Fungsi check I2C health
-bool checkI2CHealth() {
-    FoxVehicleData data = foxVehicleGetData();
-    
-    // Saat charging, cek lebih jarang
-    unsigned long checkInterval = (data.mode == MODE_CHARGING) ? 10000 : 1000;
+// ========== ASYNC FLUSH ==========
+// loop() menggambar ke buffer Adafruit (back buffer). displayFlush() hanya menyalin
+// frame selesai ke slot pending dan membangunkan task flush, tanpa menunggu bus.
+// Frame pending yang belum sempat dikirim ditimpa frame baru (superseded).
+#ifdef ESP32
+static void oledFlushTask(void* arg) {
+    for(;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        
+        portENTER_CRITICAL(&oledPendingMux);
+        bool ready = oledPendingReady;
+        bool full = oledPendingFull;
+        if(ready) {
+            memcpy(oledFront, oledPending, sizeof(oledFront));
+            oledPendingReady = false;
+            oledPendingFull = false;
+        }
+        portEXIT_CRITICAL(&oledPendingMux);
+        if(!ready) continue;
+        
+        xSemaphoreTake(oledBusMutex, portMAX_DELAY);
+        oledSendFrame(oledFront, full);
+        xSemaphoreGive(oledBusMutex);
+    }
+}
+
+static bool startFlushTask() {
+    if(oledFlushTaskHandle != NULL) return true;
+    oledBusMutex = xSemaphoreCreateMutex();
+    if(oledBusMutex == NULL) return false;
+    return xTaskCreatePinnedToCore(oledFlushTask, "oledFlush", OLED_FLUSH_TASK_STACK, NULL,
+                                   OLED_FLUSH_TASK_PRIORITY, &oledFlushTaskHandle,
+                                   OLED_FLUSH_TASK_CORE) == pdPASS;
+}
+#endif
+
+// Fungsi: Page flip, dipanggil setelah frame selesai digambar.
+// forceFull diserahkan bersama frame di critical section yang sama; frame pending
+// yang ditimpa mewariskan permintaan flush penuhnya.
+void displayFlush(bool forceFull) {
+#ifdef ESP32
+    if(oledFlushTaskHandle != NULL) {
+        portENTER_CRITICAL(&oledPendingMux);
+        if(oledPendingReady) {
+            oledFramesSuperseded++;
+        }
+        memcpy(oledPending, display.getBuffer(), sizeof(oledPending));
+        oledPendingFull = oledPendingFull || forceFull;
+        oledPendingReady = true;
+        portEXIT_CRITICAL(&oledPendingMux);
+        xTaskNotifyGive(oledFlushTaskHandle);
+        return;
+    }
+#endif
+    // Tanpa task flush: kirim langsung (blocking)
+    oledSendFrame(display.getBuffer(), forceFull);
+}
+
+// Fungsi: Akses bus OLED dari loop (begin/recovery), menunggu transfer task selesai
+static void lockDisplayBus() {
+#ifdef ESP32
+    if(oledBusMutex != NULL) xSemaphoreTake(oledBusMutex, portMAX_DELAY);
+#endif
+}
+
+static void unlockDisplayBus() {
+#ifdef ESP32
+    if(oledBusMutex != NULL) xSemaphoreGive(oledBusMutex);
+#endif
+}
+
+// ========== I2C RECOVERY ==========
+// State machine non-blocking: satu langkah per foxDisplayRecoveryUpdate(), jeda
+// stabilisasi pin ditunggu lewat timer, bukan delay(). Selama recovery bus
+// offline: transaksi (flush OLED, baca RTC) langsung gagal tanpa menunggu.
+enum I2CRecoveryState {
+    RECOVERY_IDLE = 0,
+    RECOVERY_BACKOFF,       // Menunggu jeda sebelum percobaan berikutnya
+    RECOVERY_RELEASE,       // Wire.end(), pin high-impedance
+    RECOVERY_PULSE,         // Clock pulse untuk melepas slave yang menahan SDA
+    RECOVERY_PULLUP,        // Pin pull-up, tunggu stabil
+    RECOVERY_PROBE,         // Wire.begin() ulang, cari OLED satu alamat per langkah
+    RECOVERY_BEGIN          // Re-init SSD1306
+};
+
+static const uint8_t oledProbeAddresses[] = {0x3C, 0x3D};
+
+I2CRecoveryState recoveryState = RECOVERY_IDLE;
+unsigned long recoveryStepAt = 0;       // Langkah berikutnya tidak sebelum waktu ini
+unsigned long recoveryFaultMs = 0;      // Awal gangguan (untuk time-to-recover)
+unsigned long recoveryOkMs = 0;         // Recovery sukses terakhir
+unsigned long recoveryBackoffMs = 0;    // 0 = percobaan berikutnya langsung
+uint8_t recoveryProbeIndex = 0;
+uint8_t recoveryAddress = 0;
+FoxI2CRecoveryStats recoveryStats;
+
+static void recoveryWait(I2CRecoveryState next, unsigned long waitMs) {
+    recoveryState = next;
+    recoveryStepAt = millis() + waitMs;
+}
+
+static void startRecovery(const char* reason) {
+    if(recoveryState != RECOVERY_IDLE) return;
+    recoveryFaultMs = millis();
+    recoveryStats.active = true;
+    Serial.print("[I2C] Recovery start: ");
+    Serial.println(reason);
+    recoveryWait(RECOVERY_BACKOFF, recoveryBackoffMs);
+}
+
+// Percobaan gagal: OLED tidak ditemukan / begin gagal, ulangi dengan backoff dobel
+static void recoveryAttemptFailed() {
+    recoveryStats.failures++;
+    displayInitialized = false;
     
-    if(millis() - lastI2CCheck < checkInterval) {
-        return displayInitialized;
+    recoveryBackoffMs = (recoveryBackoffMs == 0) ? I2C_RECOVERY_BACKOFF_MS : recoveryBackoffMs * 2;
+    if(recoveryBackoffMs > I2C_RECOVERY_BACKOFF_MAX_MS) {
+        recoveryBackoffMs = I2C_RECOVERY_BACKOFF_MAX_MS;
     }
+    recoveryStats.backoffMs = recoveryBackoffMs;
     
-    lastI2CCheck = millis();
+    Serial.print("[I2C] OLED tidak ditemukan, coba lagi dalam ");
+    Serial.print(recoveryBackoffMs);
+    Serial.println(" ms");
+    recoveryWait(RECOVERY_BACKOFF, recoveryBackoffMs);
+}
+
+static void recoverySucceeded() {
+    unsigned long now = millis();
+    unsigned long recoverMs = now - recoveryFaultMs;
     
-    if(!displayInitialized) {
-        return false;
-    }
+    recoveryStats.successes++;
+    recoveryStats.lastRecoverMs = recoverMs;
+    if(recoverMs > recoveryStats.maxRecoverMs) recoveryStats.maxRecoverMs = recoverMs;
+    recoveryStats.totalDownMs += recoverMs;
+    recoveryStats.active = false;
+    recoveryOkMs = now;
     
-    // Test koneksi ke OLED
-    Wire.beginTransmission(OLED_ADDRESS);
-    byte error = Wire.endTransmission();
+    displayInitialized = true;
+    renderForced = true;
+    recoveryState = RECOVERY_IDLE;
     
-    if(error != 0) {
-        i2cErrorCount++;
-        lastI2CErrorTime = millis();
-        
-        // Log error dengan throttling
-        static unsigned long lastErrorLog = 0;
-        if(millis() - lastErrorLog > 5000) {
-            Serial.print("[I2C] Error #");
-            Serial.print(i2cErrorCount);
-            Serial.print(" Code: ");
-            Serial.println(error);
-            lastErrorLog = millis();
+    Serial.print("[I2C] Recovery OK dalam ");
+    Serial.print(recoverMs);
+    Serial.println(" ms");
+}
+
+static void recoveryStep() {
+    switch(recoveryState) {
+        case RECOVERY_BACKOFF:
+            recoveryStats.attempts++;
+            recoveryState = RECOVERY_RELEASE;
+            break;
+            
+        case RECOVERY_RELEASE:
+            // Tunggu transaksi yang sedang jalan (chunk flush / baca RTC) selesai
+            foxI2CAcquire(I2C_PRIO_HIGH);
+            foxI2CSetOffline(true);
+            Wire.end();
+            foxI2CRelease();
+            pinMode(SDA_PIN, INPUT);
+            pinMode(SCL_PIN, INPUT);
+            recoveryWait(RECOVERY_PULSE, I2C_RECOVERY_SETTLE_MS);
+            break;
+            
+        case RECOVERY_PULSE:
+            // 20 pulse x 20 us, cukup pendek untuk satu langkah
+            pinMode(SCL_PIN, OUTPUT);
+            for(int i = 0; i < 20; i++) {
+                digitalWrite(SCL_PIN, LOW);
+                delayMicroseconds(10);
+                digitalWrite(SCL_PIN, HIGH);
+                delayMicroseconds(10);
+            }
+            pinMode(SDA_PIN, INPUT_PULLUP);
+            pinMode(SCL_PIN, INPUT_PULLUP);
+            recoveryWait(RECOVERY_PULLUP, I2C_RECOVERY_SETTLE_MS);
+            break;
+            
+        case RECOVERY_PULLUP:
+            // Clock dipasang ulang bus manager (adaptif)
+            foxI2CAcquire(I2C_PRIO_HIGH);
+            foxI2CRestart();
+            foxI2CSetOffline(false);
+            foxI2CRelease();
+            recoveryProbeIndex = 0;
+            recoveryState = RECOVERY_PROBE;
+            break;
+            
+        case RECOVERY_PROBE: {
+            if(recoveryProbeIndex >= sizeof(oledProbeAddresses)) {
+                recoveryAttemptFailed();
+                break;
+            }
+            uint8_t address = oledProbeAddresses[recoveryProbeIndex++];
+            foxI2CAcquire(I2C_PRIO_NORMAL);
+            Wire.beginTransmission(address);
+            byte error = Wire.endTransmission();
+            foxI2CRelease();
+            if(error == 0) {
+                recoveryAddress = address;
+                recoveryState = RECOVERY_BEGIN;
+            }
+            break;
         }
-        
-        // Auto-recovery jika banyak error
-        if(i2cErrorCount >= 5) {
-            Serial.println("[I2C] Multiple errors, attempting recovery...");
-            recoverI2C();
-            i2cErrorCount = 0;
+            
+        case RECOVERY_BEGIN: {
+            // Task flush tidak boleh mengirim frame di tengah re-init
+            lockDisplayBus();
+            foxI2CAcquire(I2C_PRIO_NORMAL);
+            bool ok = display.begin(SSD1306_SWITCHCAPVCC, recoveryAddress);
+            foxI2CRelease();
+            if(ok) {
+                foxI2CSetAddress(I2C_DEV_OLED, recoveryAddress);
+                oledShadowValid = false;
+            }
+            unlockDisplayBus();
+            
+            if(ok) {
+                recoverySucceeded();
+            } else {
+                recoveryAttemptFailed();
+            }
+            break;
         }
-        
-        return false;
+            
+        default:
+            recoveryState = RECOVERY_IDLE;
+            break;
     }
+}
+
+// Fungsi: Minta recovery bus (non-blocking, dijalankan foxDisplayRecoveryUpdate)
+void recoverI2C() {
+    startRecovery("manual");
+}
+
+// Gangguan dideteksi dari hasil transfer nyata (flush OLED), tanpa transaksi probe
+static void recoveryTick() {
+    unsigned long now = millis();
     
-    // Reset error count jika berhasil
-    if(i2cErrorCount > 0) {
-        i2cErrorCount = 0;
+    if(recoveryState == RECOVERY_IDLE) {
+        if(recoveryBackoffMs > 0 && now - recoveryOkMs > I2C_RECOVERY_STABLE_MS) {
+            recoveryBackoffMs = 0;
+            recoveryStats.backoffMs = 0;
+        }
+        if(displayInitialized && foxI2CConsecutiveErrors(I2C_DEV_OLED) >= I2C_RECOVERY_ERRORS) {
+            startRecovery("error transfer OLED berturut-turut");
+        }
+        return;
     }
     
-    return true;
+    if((long)(now - recoveryStepAt) < 0) return;
+    recoveryStep();
+}
+
+// Fungsi: Health pasif + langkah recovery, dipanggil setiap loop()
+void foxDisplayRecoveryUpdate() {
+    uint32_t start = micros();
+    recoveryTick();
+    recordTiming(timingHealth, micros() - start);
+}
+
+bool foxDisplayIsRecovering() {
+    return recoveryState != RECOVERY_IDLE;
+}
+
+FoxI2CRecoveryStats foxDisplayGetRecoveryStats() {
+    FoxI2CRecoveryStats stats = recoveryStats;
+    if(stats.active) {
+        stats.currentDownMs = millis() - recoveryFaultMs;
+    }
+    return stats;
+}
+
+void foxDisplayPrintRecoveryStatus() {
+    FoxI2CRecoveryStats stats = foxDisplayGetRecoveryStats();
+    Serial.printf("Recovery: %lu attempts, %lu ok, %lu failed%s\n",
+                  (unsigned long)stats.attempts, (unsigned long)stats.successes,
+                  (unsigned long)stats.failures, stats.active ? " (RUNNING)" : "");
+    Serial.printf("Time-to-recover: last %lu ms, max %lu ms, total down %lu ms\n",
+                  stats.lastRecoverMs, stats.maxRecoverMs, stats.totalDownMs);
+    if(stats.active) {
+        Serial.printf("Down for %lu ms, next backoff %lu ms\n", stats.currentDownMs, stats.backoffMs);
+    }
 }
 
 // Fungsi untuk akses dari JAMFOXRSBETA.ino
 int getI2CErrorCount() {
-    return i2cErrorCount;
+    return foxI2CConsecutiveErrors(I2C_DEV_OLED);
 }
 
 unsigned long getLastI2CErrorTime() {
-    return lastI2CErrorTime;
+    return foxI2CGetStats(I2C_DEV_OLED).lastErrorMs;
 }
 
 void foxDisplayInit() {
     Serial.println("Initializing OLED...");
     
-    // Reset I2C bus dulu untuk hindari NACK error
-    Wire.begin(SDA_PIN, SCL_PIN);
-    Wire.setClock(100000); // 100kHz
+    initGlyphCache();
+    
+    // Bus sudah di-init foxI2CInit(); scan & begin Adafruit pakai Wire langsung
     delay(100);
+    foxI2CAcquire(I2C_PRIO_NORMAL);
     
     // Coba multiple address untuk OLED
     uint8_t oledAddresses[] = {0x3C, 0x3D}; // Common OLED addresses
     bool oledFound = false;
+    uint8_t foundAddress = 0;
     byte error;
     
     for(int i = 0; i < 2; i++) {
@@ -189,18 +594,29 @@ void foxDisplayInit() {
             } else {
                 Serial.println("OLED initialized successfully!");
                 displayInitialized = true;
+                foundAddress = oledAddresses[i];
+                oledShadowValid = false;
                 oledFound = true;
                 break;
             }
         }
         delay(50);
     }
+    foxI2CRelease();
     
     if(!oledFound) {
         Serial.println("OLED NOT FOUND at any address!");
         displayInitialized = false;
         return;
     }
+    foxI2CSetAddress(I2C_DEV_OLED, foundAddress);
+    
+#ifdef ESP32
+    // Transfer I2C di task sendiri supaya loop() tidak menunggu bus
+    if(!startFlushTask()) {
+        Serial.println("OLED: gagal membuat task flush, flush langsung");
+    }
+#endif
     
     // ========== SPLASH SCREEN ==========
     display.clearDisplay();
@@ -208,7 +624,7 @@ void foxDisplayInit() {
     display.setTextColor(SSD1306_WHITE);
     display.setCursor(0, 10);
     display.print(SPLASH_TEXT);
-    display.display();
+    displayFlush();
     
     delay(SPLASH_DURATION_MS);
     
@@ -225,11 +641,9 @@ void foxDisplayInit() {
     RTCDateTime dt = foxRTCGetDateTime();
     
     // Jam besar
-    display.setFont(&FreeSansBold18pt7b);
     char timeStr[6];
-    snprintf(timeStr, sizeof(timeStr), CLOCK_TIME_FORMAT, dt.hour, dt.minute);
-    display.setCursor(0, 28);
-    display.print(timeStr);
+    foxFormatTime(timeStr, sizeof(timeStr), dt.hour, dt.minute, -1, CLOCK_HOUR_LEADING_ZERO);
+    printCached(clockGlyphs, 0, timeStr);
     
     // Info tanggal
     display.setFont();
@@ -253,16 +667,18 @@ void foxDisplayInit() {
     display.print(hari[hariIndex]);
     
     char tanggalBulan[10];
-    snprintf(tanggalBulan, sizeof(tanggalBulan), CLOCK_DATE_FORMAT, dt.day, bulan[bulanIndex]);
+    size_t len = foxFormatUInt(tanggalBulan, sizeof(tanggalBulan), dt.day);
+    len = foxFormatAppend(tanggalBulan, sizeof(tanggalBulan), len, " ");
+    foxFormatAppend(tanggalBulan, sizeof(tanggalBulan), len, bulan[bulanIndex]);
     display.setCursor(rightCol, 15);
     display.print(tanggalBulan);
     
     char yearStr[5];
-    snprintf(yearStr, sizeof(yearStr), CLOCK_YEAR_FORMAT, dt.year);
+    foxFormatUInt(yearStr, sizeof(yearStr), dt.year, 4);
     display.setCursor(rightCol, 25);
     display.print(yearStr);
     
-    display.display();
+    displayFlush();
     
     Serial.println("Display showing default clock page");
 }
@@ -271,144 +687,339 @@ bool foxDisplayIsInitialized() {
     return displayInitialized;
 }
 
-// ========== MODIFIKASI UTAMA: foxDisplayUpdate() ==========
+// ========== RENDER SCHEDULER ==========
+// Page dirender hanya saat content key berubah (nilai yang benar-benar tampil: menit,
+// speed, fase kedip), maksimal DISPLAY_MAX_FPS. Frame hasil render di-hash dan tidak
+// di-flush jika identik dengan frame terakhir. Watchdog DISPLAY_MIN_REFRESH_MS memaksa
+// render + flush penuh supaya GDDRAM yang rusak (noise) tidak bertahan.
+#define DISPLAY_MIN_FRAME_MS (1000 / DISPLAY_MAX_FPS)
+#define KEY_SEED 2166136261u
+
+int renderedPage = -1;
+uint32_t renderedKey = 0;
+uint32_t renderedFrameHash = 0;
+unsigned long lastRenderMs = 0;
+
+// RTC dibaca maksimal sekali per DISPLAY_CLOCK_SAMPLE_MS (content key dicek tiap loop)
+RTCDateTime displayClockNow;
+unsigned long displayClockSampleMs = 0;
+bool displayClockValid = false;
+
+static RTCDateTime displayClock() {
+    unsigned long now = millis();
+    if(!displayClockValid || now - displayClockSampleMs >= DISPLAY_CLOCK_SAMPLE_MS) {
+        displayClockNow = foxRTCGetDateTime();
+        displayClockSampleMs = now;
+        displayClockValid = true;
+    }
+    return displayClockNow;
+}
+
+// FNV-1a per nilai
+static uint32_t keyMix(uint32_t key, int32_t value) {
+    key ^= (uint32_t)value;
+    return key * 16777619u;
+}
+
+static uint32_t frameHash(const uint8_t* frame) {
+    uint32_t hash = KEY_SEED;
+    for(uint16_t i = 0; i < OLED_BUFFER_SIZE; i++) {
+        hash = (hash ^ frame[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t signalKey(uint32_t key, const FoxVehicleData& data, FoxVehicleSignal signal, int32_t value) {
+    // Nilai signal stale tampil "--", nilainya tidak relevan
+    if(!foxSignalValid(data, signal)) return keyMix(key, INT32_MIN);
+    return keyMix(key, value);
+}
+
+// Fungsi: Content key page = hash nilai yang ditampilkan page (dengan pembulatan tampilan)
+static uint32_t pageContentKey(int page, const FoxVehicleData& data) {
+    uint32_t key = keyMix(KEY_SEED, page);
+    
+    if(page == PAGE_CLOCK || page == PAGE_CHARGING) {
+        RTCDateTime dt = displayClock();
+        key = keyMix(key, dt.hour * 60 + dt.minute);
+        if(page == PAGE_CLOCK) {
+            key = keyMix(key, dt.dayOfWeek);
+            key = keyMix(key, dt.day);
+            key = keyMix(key, dt.month);
+            key = keyMix(key, dt.year);
+        }
+    }
+    else if(page == PAGE_TEMP) {
+        key = signalKey(key, data, SIGNAL_TEMP_CONTROLLER, data.tempController);
+        key = signalKey(key, data, SIGNAL_TEMP_MOTOR, data.tempMotor);
+        key = signalKey(key, data, SIGNAL_TEMP_BATTERY, data.tempBattery);
+    }
+    else if(page == PAGE_ELECTRICAL) {
+        key = signalKey(key, data, SIGNAL_VOLTAGE, lroundf(data.voltage * 10));
+        key = signalKey(key, data, SIGNAL_CURRENT, lroundf(data.current * 10));
+    }
+    else if(page == PAGE_TRIP) {
+        FoxTripData trip = foxTripGetData();
+        // Key mengikuti angka yang tampil: di bawah 10 km satu desimal dibulatkan seperti
+        // foxFormatFloat (double), di atasnya km bulat dipotong; Wh/km tampil '-' di bawah 0.1 km
+        if(trip.distanceKm < 10.0f) {
+            key = keyMix(key, lround((double)trip.distanceKm * 10));
+        } else {
+            key = keyMix(key, 1000 + (int32_t)trip.distanceKm);
+        }
+        key = keyMix(key, trip.distanceKm < 0.1f);
+        key = keyMix(key, (int32_t)trip.whPerKm);
+        key = keyMix(key, (int32_t)trip.rangeKm);
+    }
+    else if(page == PAGE_SPORT) {
+        key = keyMix(key, data.mode);
+        if(data.mode == MODE_CRUISE || data.mode == MODE_SPORT_CRUISE) {
+            key = keyMix(key, (millis() / BLINK_INTERVAL_MS) & 1);
+        } else if(data.speedKmh >= SPEED_TRIGGER_SPORT_PAGE) {
+            // Di bawah trigger layar hanya "SPORT", speed tidak tampil
+            key = signalKey(key, data, SIGNAL_SPEED, data.speedKmh);
+        }
+    }
+    return key;
+}
+
+static void displayPageCharging() {
+    RTCDateTime dt = displayClock();
+    
+    // SIMPLE DISPLAY - minimal I2C traffic
+    display.setTextSize(2); // Font besar
+    
+    // CHARGING di tengah atas
+    display.setCursor(15, 0);
+    display.print("CHARGING");
+    
+    // JAM di tengah bawah
+    char timeStr[6];
+    foxFormatTime(timeStr, sizeof(timeStr), dt.hour, dt.minute, -1, false);
+    display.setTextSize(1);
+    display.setCursor(48, 20);
+    display.print(timeStr);
+}
+
+static void renderPage(int page, const FoxVehicleData& vehicleData) {
+    display.clearDisplay();
+    display.setTextColor(SSD1306_WHITE);
+    display.setFont();
+    display.setTextSize(FONT_SIZE_SMALL);
+    
+    // Switch berdasarkan page
+    if(page == PAGE_CHARGING) {
+        displayPageCharging();
+    }
+    else if(page == PAGE_CLOCK) {
+        #if PAGE_CLOCK_ENABLED
+            displayPageClock();
+        #else
+            showPageDisabled(1);
+        #endif
+    }
+    else if(page == PAGE_TEMP) {
+        #if PAGE_TEMP_ENABLED
+            displayPageTemperature(vehicleData);
+        #else
+            showPageDisabled(2);
+        #endif
+    }
+    else if(page == PAGE_ELECTRICAL) {
+        displayPageElectrical(vehicleData);
+    }
+    else if(page == PAGE_TRIP) {
+        #if PAGE_TRIP_ENABLED
+            displayPageTrip();
+        #else
+            showPageDisabled(4);
+        #endif
+    }
+    else if(page == PAGE_SPORT) {
+        displayPageSport(vehicleData);
+    }
+    else {
+        showPageDisabled(page);
+    }
+}
+
+// Fungsi: Dipanggil setiap loop; render + flush hanya jika isi layar berubah
 void foxDisplayUpdate(int page) {
-    // Skip update jika display tidak initialized
-    if(!displayInitialized) {
+    // Skip update jika display tidak initialized atau bus sedang recovery
+    if(!displayInitialized || recoveryState != RECOVERY_IDLE) {
         return;
     }
     
-    // Cek I2C health sebelum update (kecuali untuk charging)
-    FoxVehicleData vehicleData = foxVehicleGetData();
+    const FoxVehicleData& vehicleData = foxVehicleGetDataRef();
     
-    // ========== HANDLE CHARGING MODE ==========
-    if(vehicleData.mode == MODE_CHARGING) {
-        // Gunakan page khusus untuk charging (99)
-        if(page == 99) {
-            static uint8_t lastDisplayedSOC = 0;
-            static float lastDisplayedVoltage = 0;
-            static unsigned long lastDisplayUpdate = 0;
-            static String lastTimeStr = "";
-            
-            // Ambil waktu sekarang
-            RTCDateTime dt = foxRTCGetDateTime();
-            String currentTimeStr = String(dt.hour) + ":" + (dt.minute < 10 ? "0" : "") + String(dt.minute);
-            
-            // Update hanya jika ada perubahan signifikan atau setiap 30 detik
-            bool socChanged = (abs((int)vehicleData.soc - (int)lastDisplayedSOC) > 1);
-            bool voltChanged = (fabs(vehicleData.voltage - lastDisplayedVoltage) > 0.5);
-            bool timeChanged = (currentTimeStr != lastTimeStr);
-            bool timeout = (millis() - lastDisplayUpdate > 30000);
-            
-            if(!socChanged && !voltChanged && !timeChanged && !timeout) {
-                return; // Skip update
-            }
-            
-            // SIMPLE DISPLAY - minimal I2C traffic
-            display.clearDisplay();
-            display.setTextSize(2); // Font besar
-            
-            // CHARGING di tengah atas
-            display.setCursor(15, 0);
-            display.print("CHARGING");
-            
-            // JAM di kiri bawah (persentase)
-            display.setTextSize(1);
-            display.setCursor(48, 20);
-            display.print(currentTimeStr);
-            
-            display.display();
-            
-            // Update trackers
-            lastDisplayedSOC = vehicleData.soc;
-            lastDisplayedVoltage = vehicleData.voltage;
-            lastTimeStr = currentTimeStr;
-            lastDisplayUpdate = millis();
-            return;
-        }
-        // Untuk page lain, skip saat charging
+    // Saat charging hanya page charging yang tampil
+    if(vehicleData.mode == MODE_CHARGING && page != PAGE_CHARGING) {
         return;
     }
     
-    // Cek I2C health untuk mode normal
-    if(!checkI2CHealth()) {
+    unsigned long now = millis();
+    FoxDisplayPageStats& stats = pageStats[statsPageSlot(page)];
+    if(statsLastUpdateMs != 0) {
+        stats.activeMs += now - statsLastUpdateMs;
+    }
+    statsLastUpdateMs = now;
+    
+    // Flush gagal: render + flush penuh lagi tanpa menunggu key berubah / watchdog,
+    // supaya page statis tetap menambah error berturut-turut sampai I2C_RECOVERY_ERRORS
+    bool retry = oledFlushFailed;
+    
+    uint32_t key = pageContentKey(page, vehicleData);
+    bool changed = renderForced || retry || page != renderedPage || key != renderedKey;
+    static uint32_t seenKey = 0;
+    static int seenPage = -1;
+    if(key != seenKey || page != seenPage) {
+        stats.keyChanges++;
+        seenKey = key;
+        seenPage = page;
+    }
+    
+    bool watchdog = (now - lastRenderMs >= DISPLAY_MIN_REFRESH_MS);
+    if(!watchdog && !changed) {
+        stats.keySkips++;
         return;
     }
+    if(!watchdog && now - lastRenderMs < DISPLAY_MIN_FRAME_MS) {
+        stats.fpsDeferred++;
+        return;  // Batas FPS, dicoba lagi loop berikutnya
+    }
     
-    // Untuk SPORT page: cek apakah data berubah
-    if(page == PAGE_SPORT) {
-        bool speedChanged = (vehicleData.speedKmh != lastDisplayedSpeed);
-        bool rpmChanged = (vehicleData.rpm != lastDisplayedRPM);
-        
-        // Skip update jika tidak ada perubahan
-        if(!speedChanged && !rpmChanged && !sportNeedsUpdate) {
-            return;
-        }
-        
-        // Update nilai terakhir
-        lastDisplayedSpeed = vehicleData.speedKmh;
-        lastDisplayedRPM = vehicleData.rpm;
-        sportNeedsUpdate = false;
+    // Render ke back buffer lalu page flip; transfer I2C berjalan di task flush.
+    // Error transfer dicatat bus manager dan ditangani foxDisplayRecoveryUpdate().
+    uint32_t start = micros();
+    renderPage(page, vehicleData);
+    uint32_t hash = frameHash(display.getBuffer());
+    recordTiming(timingRender, micros() - start);
+    
+    stats.renders++;
+    renderedPage = page;
+    renderedKey = key;
+    renderForced = false;
+    lastRenderMs = now;
+    
+    if(watchdog) {
+        stats.watchdogRefreshes++;
+    } else if(hash == renderedFrameHash && !retry) {
+        stats.hashSkips++;
+        return;  // Key berubah tapi pixel sama (mis. pembulatan), bus tidak dipakai
     }
+    renderedFrameHash = hash;
+    oledFlushFailed = false;
     
-    // Attempt display update dengan retry mechanism
-    for(int retry = 0; retry < 2; retry++) {
-        if(retry > 0) {
-            delay(50);
-        }
-        
-        try {
-            display.clearDisplay();
-            display.setTextColor(SSD1306_WHITE);
-            display.setFont();
-            display.setTextSize(FONT_SIZE_SMALL);
-            
-            // Switch berdasarkan page
-            if(page == PAGE_CLOCK) {
-                #if PAGE_CLOCK_ENABLED
-                    displayPageClock();
-                #else
-                    showPageDisabled(1);
-                #endif
-            }
-            else if(page == PAGE_TEMP) {
-                #if PAGE_TEMP_ENABLED
-                    displayPageTemperature(vehicleData);
-                #else
-                    showPageDisabled(2);
-                #endif
-            }
-            else if(page == PAGE_ELECTRICAL) {
-                displayPageElectrical(vehicleData);
-            }
-            else if(page == PAGE_SPORT) {
-                displayPageSport(vehicleData);
-            }
-            else {
-                showPageDisabled(page);
-            }
-            
-            display.display();
-            return; // Success
-            
-        } catch(...) {
-            if(retry == 0) {
-                recoverI2C();
-            }
-        }
+    start = micros();
+    displayFlush(watchdog || retry);
+    recordTiming(timingHandoff, micros() - start);
+    stats.flushes++;
+}
+
+void foxDisplayRenderPage(int page) {
+    renderPage(page, foxVehicleGetDataRef());
+    // Framebuffer tidak lagi sama dengan frame terakhir scheduler
+    renderForced = true;
+}
+
+const uint8_t* foxDisplayGetFrame() {
+    return display.getBuffer();
+}
+
+// Return true jika cache siap dan dipakai
+bool foxDisplaySetGlyphCache(bool enabled) {
+    glyphCacheActive = enabled;
+    return enabled && clockGlyphs.ready && speedGlyphs.ready;
+}
+
+FoxDisplayStats foxDisplayGetStats() {
+    FoxDisplayStats stats;
+#ifdef ESP32
+    portENTER_CRITICAL(&displayStatsMux);
+#endif
+    stats.render = timingRender;
+    stats.handoff = timingHandoff;
+    stats.flush = timingFlush;
+    stats.health = timingHealth;
+#ifdef ESP32
+    portEXIT_CRITICAL(&displayStatsMux);
+#endif
+    stats.framesFlushed = oledFramesFlushed;
+    stats.framesSuperseded = oledFramesSuperseded;
+    
+    for(uint8_t i = 0; i < DISPLAY_STATS_PAGES; i++) {
+        FoxDisplayPageStats& page = stats.pages[i];
+        page = pageStats[i];
+        float seconds = page.activeMs / 1000.0f;
+        page.requestedFps = (seconds > 0) ? page.keyChanges / seconds : 0.0f;
+        page.achievedFps = (seconds > 0) ? page.flushes / seconds : 0.0f;
+    }
+    return stats;
+}
+
+void foxDisplayResetStats() {
+#ifdef ESP32
+    portENTER_CRITICAL(&displayStatsMux);
+#endif
+    memset(&timingRender, 0, sizeof(timingRender));
+    memset(&timingHandoff, 0, sizeof(timingHandoff));
+    memset(&timingFlush, 0, sizeof(timingFlush));
+    memset(&timingHealth, 0, sizeof(timingHealth));
+    oledFramesFlushed = 0;
+    oledFramesSuperseded = 0;
+#ifdef ESP32
+    portEXIT_CRITICAL(&displayStatsMux);
+#endif
+    memset(pageStats, 0, sizeof(pageStats));
+    statsLastUpdateMs = 0;
+}
+
+static void printTiming(const char* name, const FoxDisplayTiming& timing) {
+    uint32_t avg = timing.count ? (uint32_t)(timing.totalUs / timing.count) : 0;
+    Serial.printf("%-7s %8lu x  avg %6lu us  max %6lu us  |", name, (unsigned long)timing.count,
+                  (unsigned long)avg, (unsigned long)timing.maxUs);
+    for(uint8_t b = 0; b < DISPLAY_TIME_BUCKETS; b++) {
+        Serial.printf(" %lu", (unsigned long)timing.histogram[b]);
     }
+    Serial.println();
+}
+
+void foxDisplayPrintStats() {
+    static const char* pageNames[DISPLAY_STATS_PAGES] = {
+        "CLOCK", "TEMP", "ELEC", "TRIP", "SPORT", "CHARGE", "OTHER"
+    };
+    FoxDisplayStats stats = foxDisplayGetStats();
+    
+    Serial.println("=== DISPLAY STATS ===");
+    Serial.println("Timing  (histogram <100us <200 <500 <1ms <2ms <5ms <10ms >=10ms)");
+    printTiming("render", stats.render);
+    printTiming("handoff", stats.handoff);
+    printTiming("flush", stats.flush);
+    printTiming("health", stats.health);
+    Serial.printf("Frames: %lu flushed, %lu superseded\n",
+                  (unsigned long)stats.framesFlushed, (unsigned long)stats.framesSuperseded);
+    
+    Serial.println("Page    active s  req fps  fps   render  flush  keyskip  hashskip  capped  wdog");
+    for(uint8_t i = 0; i < DISPLAY_STATS_PAGES; i++) {
+        const FoxDisplayPageStats& page = stats.pages[i];
+        if(page.activeMs == 0 && page.renders == 0) continue;
+        Serial.printf("%-7s %8lu  %7.1f  %5.1f  %6lu  %5lu  %7lu  %8lu  %6lu  %4lu\n", pageNames[i],
+                      page.activeMs / 1000, page.requestedFps, page.achievedFps,
+                      (unsigned long)page.renders, (unsigned long)page.flushes,
+                      (unsigned long)page.keySkips, (unsigned long)page.hashSkips,
+                      (unsigned long)page.fpsDeferred, (unsigned long)page.watchdogRefreshes);
+    }
+    Serial.println("=====================");
 }
 
 // Fungsi display page (sama seperti sebelumnya)
 void displayPageClock() {
-    RTCDateTime dt = foxRTCGetDateTime();
+    RTCDateTime dt = displayClock();
     
-    // Jam besar menggunakan konfigurasi format
-    display.setFont(&FreeSansBold18pt7b);
+    // Jam besar menggunakan konfigurasi format (blit dari glyph cache)
     char timeStr[6];
-    snprintf(timeStr, sizeof(timeStr), CLOCK_TIME_FORMAT, dt.hour, dt.minute);
-    display.setCursor(0, 28);
-    display.print(timeStr);
+    foxFormatTime(timeStr, sizeof(timeStr), dt.hour, dt.minute, -1, CLOCK_HOUR_LEADING_ZERO);
+    printCached(clockGlyphs, 0, timeStr);
     
     // Info tanggal menggunakan konfigurasi
     display.setFont();
@@ -432,12 +1043,14 @@ void displayPageClock() {
     display.print(hari[hariIndex]);
     
     char tanggalBulan[10];
-    snprintf(tanggalBulan, sizeof(tanggalBulan), CLOCK_DATE_FORMAT, dt.day, bulan[bulanIndex]);
+    size_t len = foxFormatUInt(tanggalBulan, sizeof(tanggalBulan), dt.day);
+    len = foxFormatAppend(tanggalBulan, sizeof(tanggalBulan), len, " ");
+    foxFormatAppend(tanggalBulan, sizeof(tanggalBulan), len, bulan[bulanIndex]);
     display.setCursor(rightCol, 15);
     display.print(tanggalBulan);
     
     char yearStr[5];
-    snprintf(yearStr, sizeof(yearStr), CLOCK_YEAR_FORMAT, dt.year);
+    foxFormatUInt(yearStr, sizeof(yearStr), dt.year, 4);
     display.setCursor(rightCol, 25);
     display.print(yearStr);
 }
@@ -452,14 +1065,17 @@ void displayPageTemperature(const FoxVehicleData& vehicleData) {
     display.setCursor(86, 4);
     display.print(TEMP_LABEL_BATT);
     
-    // Angka suhu
+    // Angka suhu ("--" jika frame suhu berhenti datang)
     display.setTextSize(FONT_SIZE_MEDIUM);
     display.setCursor(0, 16);
-    display.print(vehicleData.tempController);
+    if(foxSignalValid(vehicleData, SIGNAL_TEMP_CONTROLLER)) display.print(vehicleData.tempController);
+    else display.print(STALE_TEXT);
     display.setCursor(43, 16);
-    display.print(vehicleData.tempMotor);
+    if(foxSignalValid(vehicleData, SIGNAL_TEMP_MOTOR)) display.print(vehicleData.tempMotor);
+    else display.print(STALE_TEXT);
     display.setCursor(86, 16);
-    display.print(vehicleData.tempBattery);
+    if(foxSignalValid(vehicleData, SIGNAL_TEMP_BATTERY)) display.print(vehicleData.tempBattery);
+    else display.print(STALE_TEXT);
 }
 
 void displayPageElectrical(const FoxVehicleData& vehicleData) {
@@ -481,20 +1097,23 @@ void displayPageElectrical(const FoxVehicleData& vehicleData) {
         // =============================================
         float voltage = vehicleData.voltage;
         
-        if(voltage < 0.1) {
+        if(!foxSignalValid(vehicleData, SIGNAL_VOLTAGE)) {
+            display.setCursor(0, 16);
+            display.print(STALE_TEXT);
+        } else if(voltage < 0.1) {
             // Jika voltage 0, tampilkan "0" bukan "0.0"
             display.setCursor(0, 16);
             display.print("  0");
         } else if(voltage < 10.0) {
             // Voltage 1 digit: " 7.5"
             char voltStr[6];
-            snprintf(voltStr, sizeof(voltStr), "%4.1f", voltage);
+            foxFormatFloat(voltStr, sizeof(voltStr), voltage, 1, 4);
             display.setCursor(0, 16);
             display.print(voltStr);
         } else if(voltage < 100.0) {
             // Voltage 2 digit: "75.5"
             char voltStr[6];
-            snprintf(voltStr, sizeof(voltStr), "%4.1f", voltage);
+            foxFormatFloat(voltStr, sizeof(voltStr), voltage, 1, 4);
             display.setCursor(0, 16);
             display.print(voltStr);
         } else {
@@ -509,7 +1128,10 @@ void displayPageElectrical(const FoxVehicleData& vehicleData) {
         float current = vehicleData.current;
         float absCurrent = fabs(current);
         
-        if(absCurrent < 0.1) {
+        if(!foxSignalValid(vehicleData, SIGNAL_CURRENT)) {
+            display.setCursor(86, 16);
+            display.print(STALE_TEXT);
+        } else if(absCurrent < 0.1) {
             // Current ~0, tampilkan "0" bukan "0.0"
             display.setCursor(86, 16);
             display.print("  0");
@@ -519,7 +1141,7 @@ void displayPageElectrical(const FoxVehicleData& vehicleData) {
                 if(absCurrent < 10.0) {
                     // 1 digit positif: "+2.5"
                     char currStr[6];
-                    snprintf(currStr, sizeof(currStr), "+%3.1f", current);
+                    foxFormatFloat(currStr, sizeof(currStr), current, 1, 0, true);
                     display.setCursor(76, 16);
                     display.print(currStr);
                 } else if(absCurrent < 100.0) {
@@ -538,7 +1160,7 @@ void displayPageElectrical(const FoxVehicleData& vehicleData) {
                 if(absCurrent < 10.0) {
                     // 1 digit negatif: "-2.5"
                     char currStr[6];
-                    snprintf(currStr, sizeof(currStr), "%4.1f", current);
+                    foxFormatFloat(currStr, sizeof(currStr), current, 1, 4);
                     display.setCursor(76, 16);
                     display.print(currStr);
                 } else if(absCurrent < 100.0) {
@@ -560,6 +1182,45 @@ void displayPageElectrical(const FoxVehicleData& vehicleData) {
     #endif
 }
 
+void displayPageTrip() {
+    FoxTripData trip = foxTripGetData();
+    
+    // Layout 3 kolom sama seperti page suhu
+    display.setTextSize(FONT_SIZE_SMALL);
+    display.setCursor(0, 4);
+    display.print(TRIP_LABEL_DIST);
+    display.setCursor(43, 4);
+    display.print(TRIP_LABEL_WHKM);
+    display.setCursor(86, 4);
+    display.print(TRIP_LABEL_RANGE);
+    
+    // Maksimal 3 karakter per kolom di font medium
+    char valueStr[8];
+    display.setTextSize(FONT_SIZE_MEDIUM);
+    
+    display.setCursor(0, 16);
+    if(trip.distanceKm < 10.0f) {
+        foxFormatFloat(valueStr, sizeof(valueStr), trip.distanceKm, 1);
+    } else {
+        foxFormatInt(valueStr, sizeof(valueStr), (int)trip.distanceKm % 1000);
+    }
+    display.print(valueStr);
+    
+    display.setCursor(43, 16);
+    if(trip.distanceKm < 0.1f) {
+        display.print(STALE_TEXT);
+    } else {
+        display.print((int)constrain(trip.whPerKm, -99.0f, 999.0f));
+    }
+    
+    display.setCursor(86, 16);
+    if(trip.rangeKm < 0) {
+        display.print(STALE_TEXT);
+    } else {
+        display.print((int)constrain(trip.rangeKm, 0.0f, 999.0f));
+    }
+}
+
 void displayPageSport(const FoxVehicleData& vehicleData) {
     // Deteksi mode
     bool isCruiseMode = (vehicleData.mode == MODE_CRUISE || 
@@ -577,16 +1238,14 @@ void displayPageSport(const FoxVehicleData& vehicleData) {
         if(vehicleData.speedKmh < SPEED_TRIGGER_SPORT_PAGE) {
             displaySportModeLowSpeed();
         } else {
-            displaySportModeHighSpeed(vehicleData.speedKmh);
+            displaySportModeHighSpeed(vehicleData.speedKmh, foxSignalValid(vehicleData, SIGNAL_SPEED));
         }
     }
 }
 
+// Fase kedip dari waktu, sama dengan yang dipakai content key page sport
 void updateBlinkState() {
-    if(millis() - lastBlinkTime > BLINK_INTERVAL_MS) {
-        blinkState = !blinkState;
-        lastBlinkTime = millis();
-    }
+    blinkState = ((millis() / BLINK_INTERVAL_MS) & 1) == 0;
 }
 
 void displayCruiseMode() {
@@ -613,7 +1272,7 @@ void displaySportModeLowSpeed() {
     display.print(SPORT_TEXT);
 }
 
-void displaySportModeHighSpeed(uint8_t speedKmh) {
+void displaySportModeHighSpeed(uint8_t speedKmh, bool speedValid) {
     // "SPORT MODE" kecil di tengah atas menggunakan konfigurasi
     display.setTextSize(FONT_SIZE_SMALL);
     int sportWidth = strlen(SPORT_MODE_LABEL) * 6;
@@ -621,12 +1280,14 @@ void displaySportModeHighSpeed(uint8_t speedKmh) {
     display.setCursor(sportX, POS_TOP);
     display.print(SPORT_MODE_LABEL);
     
-    // Angka speed besar
-    display.setTextSize(FONT_SIZE_LARGE);
+    // Angka speed besar (blit dari glyph cache)
     char speedStr[4];
-    snprintf(speedStr, sizeof(speedStr), "%3d", speedKmh);
-    display.setCursor(0, 10);
-    display.print(speedStr);
+    if(speedValid) {
+        foxFormatUInt(speedStr, sizeof(speedStr), speedKmh, 3, ' ');
+    } else {
+        foxFormatText(speedStr, sizeof(speedStr), STALE_TEXT, 3);
+    }
+    printCached(speedGlyphs, 0, speedStr);
     
     // "km/h" di kanan angka menggunakan konfigurasi
     display.setTextSize(FONT_SIZE_SMALL);
@@ -638,7 +1299,7 @@ void displaySportModeHighSpeed(uint8_t speedKmh) {
 }
 
 void foxDisplayForceSportUpdate() {
-    sportNeedsUpdate = true;
+    renderForced = true;
 }
 
 void foxDisplayShowSetupMode(bool blinkState) {
@@ -651,5 +1312,8 @@ void foxDisplayShowSetupMode(bool blinkState) {
     if (blinkState) {
         display.print(SETUP_TEXT);
     }
-    display.display();
+    displayFlush();
+    
+    // Layar diganti di luar scheduler, page berikutnya harus dirender ulang
+    renderForced = true;
 }
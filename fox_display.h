@@ -14,8 +14,82 @@ void foxDisplayShowSetupMode(bool blinkState);
 void foxDisplayForceSportUpdate();
 bool foxDisplayIsInitialized();
 
+// Render page ke framebuffer tanpa scheduler dan tanpa flush (renderer host, benchmark)
+void foxDisplayRenderPage(int page);
+// Framebuffer SSD1306 format page (SCREEN_WIDTH * SCREEN_HEIGHT / 8 byte)
+const uint8_t* foxDisplayGetFrame();
+// Matikan glyph cache (digit lewat Adafruit_GFX) untuk membandingkan hasil blit
+bool foxDisplaySetGlyphCache(bool enabled);
+
+// Instrumentasi pipeline display (DISPSTATS)
+// Histogram durasi: <100us, <200us, <500us, <1ms, <2ms, <5ms, <10ms, >=10ms
+#define DISPLAY_TIME_BUCKETS 8
+
+struct FoxDisplayTiming {
+    uint32_t count;
+    uint64_t totalUs;
+    uint32_t maxUs;
+    uint32_t histogram[DISPLAY_TIME_BUCKETS];
+};
+
+// Slot statistik per page
+enum FoxDisplayStatsPage {
+    DISPLAY_STATS_CLOCK = 0,
+    DISPLAY_STATS_TEMP,
+    DISPLAY_STATS_ELECTRICAL,
+    DISPLAY_STATS_TRIP,
+    DISPLAY_STATS_SPORT,
+    DISPLAY_STATS_CHARGING,
+    DISPLAY_STATS_OTHER,
+    DISPLAY_STATS_PAGES
+};
+
+struct FoxDisplayPageStats {
+    unsigned long activeMs;         // Lama page tampil
+    uint32_t keyChanges;            // Isi berubah (frame yang diminta page)
+    uint32_t renders;
+    uint32_t flushes;               // Frame yang dikirim ke task flush
+    uint32_t keySkips;              // Update di-skip, content key sama
+    uint32_t hashSkips;             // Dirender tapi frame identik, tidak di-flush
+    uint32_t fpsDeferred;           // Ditunda batas DISPLAY_MAX_FPS
+    uint32_t watchdogRefreshes;
+    float requestedFps;             // keyChanges per detik tampil
+    float achievedFps;              // flushes per detik tampil
+};
+
+struct FoxDisplayStats {
+    FoxDisplayTiming render;        // Render page + hash frame (loop)
+    FoxDisplayTiming handoff;       // displayFlush(): salin ke slot pending (loop)
+    FoxDisplayTiming flush;         // Transfer I2C satu frame (task flush)
+    FoxDisplayTiming health;        // foxDisplayRecoveryUpdate() (health pasif + recovery)
+    uint32_t framesFlushed;
+    uint32_t framesSuperseded;      // Frame pending ditimpa sebelum sempat dikirim
+    FoxDisplayPageStats pages[DISPLAY_STATS_PAGES];
+};
+
+FoxDisplayStats foxDisplayGetStats();
+void foxDisplayResetStats();
+void foxDisplayPrintStats();
+
 // I2C error handling
+// Statistik recovery bus (time-to-recover = gangguan terdeteksi -> OLED kembali)
+struct FoxI2CRecoveryStats {
+    bool active;                    // Recovery sedang berjalan
+    uint32_t attempts;
+    uint32_t successes;
+    uint32_t failures;
+    unsigned long backoffMs;        // Jeda sebelum percobaan berikutnya
+    unsigned long lastRecoverMs;
+    unsigned long maxRecoverMs;
+    unsigned long totalDownMs;
+    unsigned long currentDownMs;    // Hanya saat active
+};
+
 void recoverI2C();
+void foxDisplayRecoveryUpdate();
+bool foxDisplayIsRecovering();
+FoxI2CRecoveryStats foxDisplayGetRecoveryStats();
+void foxDisplayPrintRecoveryStatus();
 int getI2CErrorCount();
 unsigned long getLastI2CErrorTime();
 
@@ -23,16 +97,20 @@ unsigned long getLastI2CErrorTime();
 // INTERNAL FUNCTIONS (untuk fox_display.cpp)
 // =============================================
 
+// Flush framebuffer (partial, lihat OLED_PARTIAL_FLUSH); forceFull = kirim semua page
+void displayFlush(bool forceFull = false);
+
 // Page display functions
 void displayPageClock();
 void displayPageTemperature(const FoxVehicleData& vehicleData);
 void displayPageElectrical(const FoxVehicleData& vehicleData);
 void displayPageSport(const FoxVehicleData& vehicleData);
+void displayPageTrip();
 
 // Sport page helper functions
 void updateBlinkState();
 void displayCruiseMode();
 void displaySportModeLowSpeed();
-void displaySportModeHighSpeed(uint8_t speedKmh);
+void displaySportModeHighSpeed(uint8_t speedKmh, bool speedValid);
 
 #endif
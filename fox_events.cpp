@@ -0,0 +1,220 @@
+#include "fox_events.h"
+#include "fox_config.h"
+#include <Arduino.h>
+#include <math.h>
+
+// ========== SUBSCRIBER ==========
+// Tabel statis, state deadband/rate disimpan per subscriber per signal
+struct EventSubscriber {
+    const char* name;
+    FoxEventHandler handler;
+    void* context;
+    uint8_t eventMask;
+    uint16_t signalMask;
+    float deadband;
+    uint16_t minIntervalMs;
+    float threshold;
+    float hysteresis;
+
+    float lastValue[SIGNAL_COUNT];          // Nilai terakhir yang dikirim
+    unsigned long lastSentMs[SIGNAL_COUNT];
+    float pendingValue[SIGNAL_COUNT];       // Nilai terbaru yang tertahan rate limit
+    unsigned long pendingMs[SIGNAL_COUNT];
+    uint16_t sentMask;                      // lastValue valid (direset saat signal stale)
+    uint16_t pendingMask;
+    uint16_t aboveMask;                     // State threshold
+
+    uint32_t delivered;
+    uint32_t suppressed;                    // Ditahan deadband / digabung rate limit
+    bool active;
+};
+
+EventSubscriber eventSubscribers[EVENT_MAX_SUBSCRIBERS];
+uint8_t eventPendingCount = 0;              // Total bit pendingMask, fast path foxEventFlush()
+
+static void deliver(EventSubscriber& sub, FoxEventType type, FoxVehicleSignal signal,
+                    bool state, bool initial, float value, float previous, unsigned long timeMs) {
+    FoxEvent event;
+    event.type = type;
+    event.signal = signal;
+    event.state = state;
+    event.initial = initial;
+    event.value = value;
+    event.previous = previous;
+    event.timeMs = timeMs;
+    sub.delivered++;
+    sub.handler(event, sub.context);
+}
+
+static void clearPending(EventSubscriber& sub, uint8_t signal) {
+    uint16_t bit = 1u << signal;
+    if(sub.pendingMask & bit) {
+        sub.pendingMask &= ~bit;
+        eventPendingCount--;
+    }
+}
+
+static void deliverUpdate(EventSubscriber& sub, FoxVehicleSignal signal, float value, unsigned long timeMs) {
+    uint16_t bit = 1u << signal;
+    bool initial = !(sub.sentMask & bit);
+    float previous = initial ? value : sub.lastValue[signal];
+    clearPending(sub, signal);
+    sub.lastValue[signal] = value;
+    sub.lastSentMs[signal] = timeMs;
+    sub.sentMask |= bit;
+    deliver(sub, EVENT_SIGNAL_UPDATE, signal, true, initial, value, previous, timeMs);
+}
+
+static int8_t allocSubscriber() {
+    for(int8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; i++) {
+        if(!eventSubscribers[i].active) {
+            memset(&eventSubscribers[i], 0, sizeof(EventSubscriber));
+            return i;
+        }
+    }
+    Serial.println("[EVENT] Subscriber table full");
+    return -1;
+}
+
+// ========== FUNGSI PUBLIK ==========
+int8_t foxEventSubscribe(const char* name, FoxEventHandler handler, void* context,
+                         uint8_t eventMask, uint16_t signalMask,
+                         float deadband, uint16_t minIntervalMs) {
+    int8_t id = allocSubscriber();
+    if(id < 0) return -1;
+
+    EventSubscriber& sub = eventSubscribers[id];
+    sub.name = name;
+    sub.handler = handler;
+    sub.context = context;
+    sub.eventMask = eventMask;
+    sub.signalMask = signalMask;
+    sub.deadband = deadband;
+    sub.minIntervalMs = minIntervalMs;
+    sub.active = true;
+    return id;
+}
+
+int8_t foxEventSubscribeThreshold(const char* name, FoxEventHandler handler, void* context,
+                                  FoxVehicleSignal signal, float threshold, float hysteresis) {
+    int8_t id = foxEventSubscribe(name, handler, context, EVENT_MASK(EVENT_THRESHOLD),
+                                  EVENT_SIGNAL_MASK(signal));
+    if(id < 0) return -1;
+
+    eventSubscribers[id].threshold = threshold;
+    eventSubscribers[id].hysteresis = hysteresis;
+    return id;
+}
+
+void foxEventUnsubscribe(int8_t id) {
+    if(id < 0 || id >= EVENT_MAX_SUBSCRIBERS) return;
+    EventSubscriber& sub = eventSubscribers[id];
+    for(uint8_t s = 0; s < SIGNAL_COUNT; s++) {
+        clearPending(sub, s);
+    }
+    sub.active = false;
+}
+
+void foxEventPublishMode(FoxVehicleMode mode, FoxVehicleMode previous, unsigned long timeMs) {
+    for(uint8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; i++) {
+        EventSubscriber& sub = eventSubscribers[i];
+        if(!sub.active || !(sub.eventMask & EVENT_MASK(EVENT_MODE_CHANGE))) continue;
+        // Transisi mode tidak pernah di-decimate
+        deliver(sub, EVENT_MODE_CHANGE, SIGNAL_MODE, true, false, mode, previous, timeMs);
+    }
+}
+
+void foxEventPublishSignal(FoxVehicleSignal signal, float value, unsigned long timeMs) {
+    uint16_t bit = 1u << signal;
+
+    for(uint8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; i++) {
+        EventSubscriber& sub = eventSubscribers[i];
+        if(!sub.active || !(sub.signalMask & bit)) continue;
+
+        if(sub.eventMask & EVENT_MASK(EVENT_SIGNAL_UPDATE)) {
+            if((sub.sentMask & bit) && fabs(value - sub.lastValue[signal]) < sub.deadband) {
+                // Kembali ke dalam deadband: nilai tertahan sudah tidak relevan
+                clearPending(sub, signal);
+                sub.suppressed++;
+            } else if(sub.minIntervalMs == 0 || !(sub.sentMask & bit) ||
+                      timeMs - sub.lastSentMs[signal] >= sub.minIntervalMs) {
+                deliverUpdate(sub, signal, value, timeMs);
+            } else {
+                // Terlalu cepat, simpan nilai terbaru untuk foxEventFlush()
+                if(!(sub.pendingMask & bit)) {
+                    sub.pendingMask |= bit;
+                    eventPendingCount++;
+                }
+                sub.pendingValue[signal] = value;
+                sub.pendingMs[signal] = timeMs;
+                sub.suppressed++;
+            }
+        }
+
+        if(sub.eventMask & EVENT_MASK(EVENT_THRESHOLD)) {
+            bool wasAbove = (sub.aboveMask & bit) != 0;
+            bool above = wasAbove ? (value >= sub.threshold - sub.hysteresis) : (value >= sub.threshold);
+            bool first = !(sub.sentMask & bit);
+            float previous = first ? value : sub.lastValue[signal];
+            sub.lastValue[signal] = value;
+            sub.sentMask |= bit;
+            if(first || above != wasAbove) {
+                if(above) sub.aboveMask |= bit;
+                else sub.aboveMask &= ~bit;
+                deliver(sub, EVENT_THRESHOLD, signal, above, first, value, previous, timeMs);
+            }
+        }
+    }
+}
+
+void foxEventPublishValidity(FoxVehicleSignal signal, bool valid, unsigned long timeMs) {
+    uint16_t bit = 1u << signal;
+
+    for(uint8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; i++) {
+        EventSubscriber& sub = eventSubscribers[i];
+        if(!sub.active || !(sub.signalMask & bit)) continue;
+
+        if(!valid) {
+            // Nilai setelah stale selalu dikirim, tanpa deadband
+            clearPending(sub, signal);
+            sub.sentMask &= ~bit;
+        }
+        if(sub.eventMask & EVENT_MASK(EVENT_VALIDITY)) {
+            deliver(sub, EVENT_VALIDITY, signal, valid, false, 0.0f, 0.0f, timeMs);
+        }
+    }
+}
+
+// Kirim update yang tertahan rate limit setelah interval subscriber lewat
+void foxEventFlush(unsigned long now) {
+    if(eventPendingCount == 0) return;
+
+    for(uint8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; i++) {
+        EventSubscriber& sub = eventSubscribers[i];
+        if(!sub.active || sub.pendingMask == 0) continue;
+
+        for(uint8_t s = 0; s < SIGNAL_COUNT; s++) {
+            if(!(sub.pendingMask & (1u << s))) continue;
+            if(now - sub.lastSentMs[s] < sub.minIntervalMs) continue;
+            deliverUpdate(sub, (FoxVehicleSignal)s, sub.pendingValue[s], sub.pendingMs[s]);
+        }
+    }
+}
+
+void foxEventPrintStatus() {
+    Serial.println("=== EVENT SUBSCRIBERS ===");
+    for(uint8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; i++) {
+        const EventSubscriber& sub = eventSubscribers[i];
+        if(!sub.active) continue;
+        if(sub.eventMask & EVENT_MASK(EVENT_THRESHOLD)) {
+            Serial.printf("%-10s signals 0x%03X threshold %.1f hyst %.1f: %lu sent\n",
+                          sub.name, sub.signalMask, sub.threshold, sub.hysteresis,
+                          (unsigned long)sub.delivered);
+        } else {
+            Serial.printf("%-10s signals 0x%03X deadband %.1f interval %u ms: %lu sent, %lu suppressed\n",
+                          sub.name, sub.signalMask, sub.deadband, sub.minIntervalMs,
+                          (unsigned long)sub.delivered, (unsigned long)sub.suppressed);
+        }
+    }
+    Serial.println("=========================");
+}
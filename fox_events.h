@@ -0,0 +1,51 @@
+#ifndef FOX_EVENTS_H
+#define FOX_EVENTS_H
+
+#include <Arduino.h>
+#include "fox_vehicle.h"
+
+// Jenis event (bit di eventMask subscriber, pakai EVENT_MASK())
+enum FoxEventType {
+    EVENT_MODE_CHANGE = 0,      // value = mode baru, previous = mode lama
+    EVENT_SIGNAL_UPDATE,        // Update signal yang lolos deadband & rate subscriber
+    EVENT_THRESHOLD,            // Signal melewati threshold subscriber (state = di atas)
+    EVENT_VALIDITY,             // Signal jadi valid / stale (state = valid)
+    EVENT_TYPE_COUNT
+};
+
+#define EVENT_MASK(type) (1u << (type))
+#define EVENT_SIGNAL_MASK(signal) (1u << (signal))
+
+struct FoxEvent {
+    FoxEventType type;
+    FoxVehicleSignal signal;
+    bool state;
+    bool initial;               // State awal (update pertama sejak subscribe / signal valid lagi)
+    float value;
+    float previous;             // Nilai terakhir yang dikirim ke subscriber ini
+    unsigned long timeMs;       // Waktu tiba frame pembawa signal
+};
+
+typedef void (*FoxEventHandler)(const FoxEvent& event, void* context);
+
+// deadband: update dikirim jika |nilai - nilai terakhir dikirim| >= deadband (0 = setiap update)
+// minIntervalMs: rate maksimum per signal; update yang tertahan dikirim nilai terbarunya saat
+// interval lewat, jadi nilai akhir tidak pernah hilang
+int8_t foxEventSubscribe(const char* name, FoxEventHandler handler, void* context,
+                         uint8_t eventMask, uint16_t signalMask,
+                         float deadband = 0.0f, uint16_t minIntervalMs = 0);
+// Naik saat nilai >= threshold, turun saat nilai < threshold - hysteresis.
+// State awal dikirim pada update pertama (initial = true), juga setelah signal stale.
+int8_t foxEventSubscribeThreshold(const char* name, FoxEventHandler handler, void* context,
+                                  FoxVehicleSignal signal, float threshold, float hysteresis = 0.0f);
+void foxEventUnsubscribe(int8_t id);
+
+// Dipanggil modul vehicle (publisher) setelah snapshot dipublish
+void foxEventPublishMode(FoxVehicleMode mode, FoxVehicleMode previous, unsigned long timeMs);
+void foxEventPublishSignal(FoxVehicleSignal signal, float value, unsigned long timeMs);
+void foxEventPublishValidity(FoxVehicleSignal signal, bool valid, unsigned long timeMs);
+void foxEventFlush(unsigned long now);
+
+void foxEventPrintStatus();
+
+#endif
@@ -0,0 +1,118 @@
+#include "fox_format.h"
+#include <math.h>
+
+// Angka terpanjang: 10 digit + titik + tanda, ditambah padding width
+#define FORMAT_TMP_SIZE 24
+
+// Salin hasil ke buffer pemanggil, terpotong jika perlu
+static size_t copyOut(char* out, size_t size, const char* text, size_t len) {
+    if(size == 0) return 0;
+    if(len > size - 1) len = size - 1;
+    memcpy(out, text, len);
+    out[len] = '\0';
+    return len;
+}
+
+// Fungsi: Bangun angka dari kanan (digit + titik desimal), lalu tanda dan padding.
+// Padding '0' diletakkan setelah tanda ("-05"), padding spasi sebelum tanda (" -5").
+static size_t formatNumber(char* out, size_t size, uint32_t magnitude, bool negative, bool plus,
+                           uint8_t decimals, uint8_t width, char pad) {
+    char tmp[FORMAT_TMP_SIZE];
+    char* end = tmp + sizeof(tmp);
+    char* p = end;
+    uint8_t digits = 0;
+
+    do {
+        if(decimals > 0 && digits == decimals) *--p = '.';
+        *--p = '0' + magnitude % 10;
+        magnitude /= 10;
+        digits++;
+    } while(magnitude > 0 || digits <= decimals);
+
+    char sign = negative ? '-' : (plus ? '+' : 0);
+    if(width > sizeof(tmp)) width = sizeof(tmp);
+    size_t len = (end - p) + (sign ? 1 : 0);
+
+    if(pad == '0') {
+        while(len < width) { *--p = '0'; len++; }
+        if(sign) *--p = sign;
+    } else {
+        if(sign) *--p = sign;
+        while(len < width) { *--p = pad; len++; }
+    }
+    return copyOut(out, size, p, end - p);
+}
+
+size_t foxFormatUInt(char* out, size_t size, uint32_t value, uint8_t width, char pad) {
+    return formatNumber(out, size, value, false, false, 0, width, pad);
+}
+
+size_t foxFormatInt(char* out, size_t size, int32_t value, uint8_t width, char pad) {
+    uint32_t magnitude = (value < 0) ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+    return formatNumber(out, size, magnitude, value < 0, false, 0, width, pad);
+}
+
+size_t foxFormatFixed(char* out, size_t size, int32_t scaled, uint8_t decimals, uint8_t width, bool plus) {
+    uint32_t magnitude = (scaled < 0) ? (uint32_t)(-(int64_t)scaled) : (uint32_t)scaled;
+    return formatNumber(out, size, magnitude, scaled < 0, plus && scaled > 0, decimals, width, ' ');
+}
+
+size_t foxFormatFloat(char* out, size_t size, float value, uint8_t decimals, uint8_t width, bool plus) {
+    if(isnan(value)) return foxFormatText(out, size, "nan", width);
+    if(decimals > 6) decimals = 6;
+
+    // Double supaya pembulatan sama dengan printf (3.05f = 3.0499.. -> "3.0")
+    double scale = 1.0;
+    for(uint8_t i = 0; i < decimals; i++) scale *= 10.0;
+    double scaled = round(value * scale);
+    if(scaled > 2147483647.0) scaled = 2147483647.0;
+    if(scaled < -2147483647.0) scaled = -2147483647.0;
+    return foxFormatFixed(out, size, (int32_t)scaled, decimals, width, plus);
+}
+
+size_t foxFormatTime(char* out, size_t size, uint8_t hour, uint8_t minute, int8_t second, bool padHour) {
+    char tmp[9];
+    size_t len = foxFormatUInt(tmp, sizeof(tmp), hour % 100, padHour ? 2 : 0);
+    tmp[len++] = ':';
+    len += foxFormatUInt(tmp + len, sizeof(tmp) - len, minute % 100, 2);
+    if(second >= 0) {
+        tmp[len++] = ':';
+        len += foxFormatUInt(tmp + len, sizeof(tmp) - len, second % 100, 2);
+    }
+    return copyOut(out, size, tmp, len);
+}
+
+size_t foxFormatDate(char* out, size_t size, uint8_t day, uint8_t month, uint16_t year) {
+    char tmp[11];
+    size_t len = foxFormatUInt(tmp, sizeof(tmp), day % 100, 2);
+    tmp[len++] = '/';
+    len += foxFormatUInt(tmp + len, sizeof(tmp) - len, month % 100, 2);
+    tmp[len++] = '/';
+    len += foxFormatUInt(tmp + len, sizeof(tmp) - len, year % 10000, 4);
+    return copyOut(out, size, tmp, len);
+}
+
+size_t foxFormatText(char* out, size_t size, const char* text, uint8_t width) {
+    if(size == 0) return 0;
+    size_t textLen = strlen(text);
+    size_t len = 0;
+    while(textLen + len < width && len < size - 1) {
+        out[len++] = ' ';
+    }
+    return len + copyOut(out + len, size - len, text, textLen);
+}
+
+size_t foxFormatAppend(char* out, size_t size, size_t len, const char* text) {
+    if(len >= size) return len;
+    return len + copyOut(out + len, size - len, text, strlen(text));
+}
+
+const char* foxParseUInt(const char* text, uint32_t& value) {
+    if(*text < '0' || *text > '9') return NULL;
+    value = 0;
+    while(*text >= '0' && *text <= '9') {
+        value = value * 10 + (*text - '0');
+        text++;
+    }
+    return text;
+}
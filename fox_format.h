@@ -0,0 +1,36 @@
+#ifndef FOX_FORMAT_H
+#define FOX_FORMAT_H
+
+#include <Arduino.h>
+
+// ========== FORMAT TANPA HEAP ==========
+// Pengganti String / snprintf di jalur periodik (render display, log, command).
+// Semua fungsi menulis ke buffer pemanggil, selalu diakhiri '\0' (terpotong jika
+// buffer kurang) dan mengembalikan panjang hasil. width = lebar minimal, rata kanan.
+
+size_t foxFormatUInt(char* out, size_t size, uint32_t value, uint8_t width = 0, char pad = '0');
+size_t foxFormatInt(char* out, size_t size, int32_t value, uint8_t width = 0, char pad = ' ');
+
+// Fixed-point: scaled = nilai x 10^decimals (755, 1 desimal -> "75.5").
+// plus = tanda '+' untuk nilai positif (arus regen)
+size_t foxFormatFixed(char* out, size_t size, int32_t scaled, uint8_t decimals,
+                      uint8_t width = 0, bool plus = false);
+// Dibulatkan ke fixed-point lalu foxFormatFixed()
+size_t foxFormatFloat(char* out, size_t size, float value, uint8_t decimals,
+                      uint8_t width = 0, bool plus = false);
+
+// "HH:MM" atau "HH:MM:SS" (second < 0 = tanpa detik); padHour = false -> "9:05"
+size_t foxFormatTime(char* out, size_t size, uint8_t hour, uint8_t minute,
+                     int8_t second = -1, bool padHour = true);
+// "DD/MM/YYYY"
+size_t foxFormatDate(char* out, size_t size, uint8_t day, uint8_t month, uint16_t year);
+
+// Teks rata kanan dengan spasi
+size_t foxFormatText(char* out, size_t size, const char* text, uint8_t width = 0);
+// Sambung text di posisi len (hasil fungsi format sebelumnya)
+size_t foxFormatAppend(char* out, size_t size, size_t len, const char* text);
+
+// Baca angka desimal; return posisi setelah digit terakhir, NULL jika tidak ada digit
+const char* foxParseUInt(const char* text, uint32_t& value);
+
+#endif
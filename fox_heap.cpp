@@ -0,0 +1,150 @@
+#include "fox_heap.h"
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+#if defined(ESP32) && defined(CONFIG_HEAP_USE_HOOKS)
+#include <esp_heap_caps.h>
+#endif
+
+// ========== COUNTER ==========
+// Dihitung di level malloc/realloc/calloc supaya String (realloc) dan printf panjang (malloc) ikut:
+// - host: linker --wrap=malloc,realloc,calloc,free (FOX_HEAP_WRAP_MALLOC dari host/CMakeLists.txt)
+// - ESP32: hook heap ESP-IDF (core dengan CONFIG_HEAP_USE_HOOKS)
+// Tanpa keduanya hanya operator new/delete yang terhitung.
+#if defined(FOX_HEAP_WRAP_MALLOC) || (defined(ESP32) && defined(CONFIG_HEAP_USE_HOOKS))
+#define HEAP_COUNT_MALLOC 1
+#else
+#define HEAP_COUNT_MALLOC 0
+#endif
+
+// Alokasi bisa dari task mana saja, counter atomic
+std::atomic<uint32_t> heapAllocs(0);
+std::atomic<uint32_t> heapFrees(0);
+std::atomic<uint32_t> heapAllocsAtSetup(0);
+std::atomic<uint32_t> heapBytes(0);
+std::atomic<uint32_t> heapBytesAtSetup(0);
+std::atomic<bool> heapSetupDone(false);
+uint32_t heapFreeAtSetup = 0;
+
+static inline void countAlloc(size_t size) {
+    heapAllocs.fetch_add(1, std::memory_order_relaxed);
+    heapBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+static inline void countFree() {
+    heapFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+#if defined(FOX_HEAP_WRAP_MALLOC)
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_realloc(void* p, size_t size);
+void* __real_calloc(size_t n, size_t size);
+void __real_free(void* p);
+
+void* __wrap_malloc(size_t size) {
+    countAlloc(size);
+    return __real_malloc(size);
+}
+
+// realloc yang memperbesar buffer String = alokasi baru; realloc(p, 0) = free
+void* __wrap_realloc(void* p, size_t size) {
+    if(size > 0) countAlloc(size);
+    else if(p != NULL) countFree();
+    return __real_realloc(p, size);
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+    countAlloc(n * size);
+    return __real_calloc(n, size);
+}
+
+void __wrap_free(void* p) {
+    if(p != NULL) countFree();
+    __real_free(p);
+}
+}
+#elif defined(ESP32) && defined(CONFIG_HEAP_USE_HOOKS)
+// Dipanggil heap_caps untuk setiap malloc/realloc/calloc (semua task, bisa dari ISR)
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+    (void)ptr;
+    (void)caps;
+    countAlloc(size);
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void* ptr) {
+    (void)ptr;
+    countFree();
+}
+#endif
+
+static void* countedAlloc(size_t size) {
+    if(!HEAP_COUNT_MALLOC) countAlloc(size);
+    void* p = malloc(size ? size : 1);
+    if(p == NULL) {
+#if __cpp_exceptions
+        throw std::bad_alloc();
+#else
+        abort();
+#endif
+    }
+    return p;
+}
+
+static void countedFree(void* p) {
+    if(p == NULL) return;
+    if(!HEAP_COUNT_MALLOC) countFree();
+    free(p);
+}
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t) noexcept { countedFree(p); }
+
+// ========== FUNGSI PUBLIK ==========
+void foxHeapMarkSetupDone() {
+    heapAllocsAtSetup.store(heapAllocs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    heapBytesAtSetup.store(heapBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+#ifdef ESP32
+    heapFreeAtSetup = ESP.getFreeHeap();
+#endif
+    heapSetupDone.store(true, std::memory_order_release);
+}
+
+FoxHeapStats foxHeapGetStats() {
+    FoxHeapStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.allocs = heapAllocs.load(std::memory_order_relaxed);
+    stats.frees = heapFrees.load(std::memory_order_relaxed);
+    stats.countsMalloc = HEAP_COUNT_MALLOC;
+    if(heapSetupDone.load(std::memory_order_acquire)) {
+        stats.allocsAfterSetup = stats.allocs - heapAllocsAtSetup.load(std::memory_order_relaxed);
+        stats.bytesAfterSetup = heapBytes.load(std::memory_order_relaxed) - heapBytesAtSetup.load(std::memory_order_relaxed);
+    }
+    stats.freeHeapAtSetup = heapFreeAtSetup;
+#ifdef ESP32
+    stats.freeHeap = ESP.getFreeHeap();
+    stats.minFreeHeap = ESP.getMinFreeHeap();
+    stats.largestFreeBlock = ESP.getMaxAllocHeap();
+#endif
+    return stats;
+}
+
+void foxHeapPrintStatus() {
+    FoxHeapStats stats = foxHeapGetStats();
+    Serial.println("=== HEAP ===");
+    Serial.printf("%s: %lu alloc, %lu free, %lu setelah setup (%lu bytes)\n",
+                  stats.countsMalloc ? "malloc" : "operator new (malloc tidak terhitung)",
+                  (unsigned long)stats.allocs, (unsigned long)stats.frees,
+                  (unsigned long)stats.allocsAfterSetup, (unsigned long)stats.bytesAfterSetup);
+#ifdef ESP32
+    Serial.printf("Free: %lu bytes (setup %lu), min %lu, largest block %lu\n",
+                  (unsigned long)stats.freeHeap, (unsigned long)stats.freeHeapAtSetup,
+                  (unsigned long)stats.minFreeHeap, (unsigned long)stats.largestFreeBlock);
+#endif
+    Serial.println("============");
+}
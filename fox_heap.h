@@ -0,0 +1,26 @@
+#ifndef FOX_HEAP_H
+#define FOX_HEAP_H
+
+#include <Arduino.h>
+
+// Penghitung alokasi heap di level malloc/realloc/calloc (String, printf, operator new).
+// Host: linker --wrap; ESP32: hook heap ESP-IDF jika core di-build dengan CONFIG_HEAP_USE_HOOKS,
+// selain itu hanya operator new/delete. Setelah foxHeapMarkSetupDone() (akhir setup) loop()
+// seharusnya tidak mengalokasi lagi.
+struct FoxHeapStats {
+    uint32_t allocs;            // malloc/realloc/calloc sejak boot
+    uint32_t frees;
+    uint32_t allocsAfterSetup;  // alokasi setelah foxHeapMarkSetupDone()
+    uint32_t bytesAfterSetup;
+    uint32_t freeHeap;          // ESP32: heap bebas saat ini (termasuk malloc langsung)
+    uint32_t freeHeapAtSetup;
+    uint32_t minFreeHeap;
+    uint32_t largestFreeBlock;  // Blok terbesar, turun jika heap terfragmentasi
+    bool countsMalloc;          // false = hanya operator new yang terhitung
+};
+
+void foxHeapMarkSetupDone();
+FoxHeapStats foxHeapGetStats();
+void foxHeapPrintStatus();
+
+#endif
@@ -0,0 +1,422 @@
+#include "fox_history.h"
+#include "fox_config.h"
+#include "fox_vehicle.h"
+#include <Arduino.h>
+
+// ========== FORMAT ==========
+// Semua nilai disimpan 1 byte fixed point: nilai = raw * scale + offset.
+// Raw 0xFF = tidak ada data (signal stale, loop macet, atau bucket kosong).
+#define HISTORY_NODATA 0xFF
+#define HISTORY_RAW_MAX 0xFE
+#define HISTORY_TIERS 3
+
+struct HistoryEncoding {
+    float scale;
+    float offset;
+    FoxVehicleSignal signal;
+};
+
+const HistoryEncoding historyEncoding[HIST_CHANNEL_COUNT] = {
+    { 1.0f,   0.0f,    SIGNAL_SPEED },             // 0..254 km/h
+    { 50.0f,  0.0f,    SIGNAL_RPM },               // 0..12700 rpm
+    { 1.0f,   -127.0f, SIGNAL_CURRENT },           // -127..127 A
+    { 0.25f,  40.0f,   SIGNAL_VOLTAGE },           // 40..103.5 V
+    { 0.5f,   0.0f,    SIGNAL_SOC },               // 0..127 %
+    { 1.0f,   -40.0f,  SIGNAL_TEMP_CONTROLLER },   // -40..214 C
+    { 1.0f,   -40.0f,  SIGNAL_TEMP_MOTOR },
+    { 1.0f,   -40.0f,  SIGNAL_TEMP_BATTERY },
+};
+
+// ========== STORAGE (struct-of-arrays) ==========
+// Satu array per field per channel supaya query satu channel membaca memori berurutan
+uint8_t historyT0[HIST_CHANNEL_COUNT][HISTORY_T0_LEN];
+uint8_t historyT1Min[HIST_CHANNEL_COUNT][HISTORY_T1_LEN];
+uint8_t historyT1Max[HIST_CHANNEL_COUNT][HISTORY_T1_LEN];
+uint8_t historyT1Mean[HIST_CHANNEL_COUNT][HISTORY_T1_LEN];
+uint8_t historyT2Min[HIST_CHANNEL_COUNT][HISTORY_T2_LEN];
+uint8_t historyT2Max[HIST_CHANNEL_COUNT][HISTORY_T2_LEN];
+uint8_t historyT2Mean[HIST_CHANNEL_COUNT][HISTORY_T2_LEN];
+
+struct HistoryTier {
+    uint16_t len;
+    uint16_t head;              // Slot tulis berikutnya
+    uint16_t count;             // Slot terisi (maks len)
+    unsigned long period;
+    unsigned long lastTimeMs;   // Waktu awal bucket terbaru
+};
+
+HistoryTier historyTiers[HISTORY_TIERS] = {
+    { HISTORY_T0_LEN, 0, 0, HISTORY_T0_PERIOD_MS, 0 },
+    { HISTORY_T1_LEN, 0, 0, HISTORY_T0_PERIOD_MS * HISTORY_T1_FACTOR, 0 },
+    { HISTORY_T2_LEN, 0, 0, HISTORY_T0_PERIOD_MS * HISTORY_T1_FACTOR * HISTORY_T2_FACTOR, 0 },
+};
+
+// Akumulator bucket yang sedang berjalan: [0] menuju T1, [1] menuju T2
+struct HistoryAccumulator {
+    uint32_t sum[HIST_CHANNEL_COUNT];
+    uint16_t valid[HIST_CHANNEL_COUNT];
+    uint8_t min[HIST_CHANNEL_COUNT];
+    uint8_t max[HIST_CHANNEL_COUNT];
+    uint16_t samples;           // Sample yang sudah masuk (valid maupun tidak)
+    unsigned long startMs;
+};
+
+HistoryAccumulator historyAcc[HISTORY_TIERS - 1];
+unsigned long historyNextSampleMs = 0;
+
+// ========== HELPER ==========
+static uint8_t encodeValue(uint8_t channel, float value) {
+    const HistoryEncoding& enc = historyEncoding[channel];
+    float raw = (value - enc.offset) / enc.scale + 0.5f;
+    if(raw <= 0.0f) return 0;
+    if(raw >= HISTORY_RAW_MAX) return HISTORY_RAW_MAX;
+    return (uint8_t)raw;
+}
+
+static float decodeValue(uint8_t channel, uint8_t raw) {
+    const HistoryEncoding& enc = historyEncoding[channel];
+    return raw * enc.scale + enc.offset;
+}
+
+static float channelValue(const FoxVehicleData& data, uint8_t channel) {
+    switch(channel) {
+        case HIST_SPEED: return data.speedKmh;
+        case HIST_RPM: return data.rpm;
+        case HIST_CURRENT: return data.current;
+        case HIST_VOLTAGE: return data.voltage;
+        case HIST_SOC: return data.soc;
+        case HIST_TEMP_CONTROLLER: return data.tempController;
+        case HIST_TEMP_MOTOR: return data.tempMotor;
+        case HIST_TEMP_BATTERY: return data.tempBattery;
+        default: return 0.0f;
+    }
+}
+
+static void accReset(HistoryAccumulator& acc) {
+    memset(acc.sum, 0, sizeof(acc.sum));
+    memset(acc.valid, 0, sizeof(acc.valid));
+    memset(acc.min, HISTORY_RAW_MAX, sizeof(acc.min));
+    memset(acc.max, 0, sizeof(acc.max));
+    acc.samples = 0;
+}
+
+static void accAdd(HistoryAccumulator& acc, uint8_t channel, uint8_t mn, uint8_t mx, uint8_t mean) {
+    if(mean == HISTORY_NODATA) return;
+    acc.sum[channel] += mean;
+    acc.valid[channel]++;
+    if(mn < acc.min[channel]) acc.min[channel] = mn;
+    if(mx > acc.max[channel]) acc.max[channel] = mx;
+}
+
+// Fungsi: Tutup bucket akumulator, hasil min/max/mean raw (NODATA jika kosong)
+static void accResult(const HistoryAccumulator& acc, uint8_t channel, uint8_t& mn, uint8_t& mx, uint8_t& mean) {
+    uint16_t valid = acc.valid[channel];
+    if(valid == 0) {
+        mn = mx = mean = HISTORY_NODATA;
+        return;
+    }
+    mn = acc.min[channel];
+    mx = acc.max[channel];
+    mean = (uint8_t)((acc.sum[channel] + valid / 2) / valid);
+}
+
+static void tierAdvance(HistoryTier& tier, unsigned long timeMs) {
+    tier.head = (tier.head + 1 == tier.len) ? 0 : tier.head + 1;
+    if(tier.count < tier.len) tier.count++;
+    tier.lastTimeMs = timeMs;
+}
+
+// ========== DOWNSAMPLING (O(1) per sample) ==========
+static void closeT2() {
+    HistoryAccumulator& acc = historyAcc[1];
+    HistoryTier& tier = historyTiers[2];
+    for(uint8_t ch = 0; ch < HIST_CHANNEL_COUNT; ch++) {
+        accResult(acc, ch, historyT2Min[ch][tier.head], historyT2Max[ch][tier.head], historyT2Mean[ch][tier.head]);
+    }
+    tierAdvance(tier, acc.startMs);
+    accReset(acc);
+}
+
+static void closeT1() {
+    HistoryAccumulator& acc = historyAcc[0];
+    HistoryAccumulator& next = historyAcc[1];
+    HistoryTier& tier = historyTiers[1];
+    uint16_t slot = tier.head;
+
+    if(next.samples == 0) next.startMs = acc.startMs;
+    for(uint8_t ch = 0; ch < HIST_CHANNEL_COUNT; ch++) {
+        accResult(acc, ch, historyT1Min[ch][slot], historyT1Max[ch][slot], historyT1Mean[ch][slot]);
+        accAdd(next, ch, historyT1Min[ch][slot], historyT1Max[ch][slot], historyT1Mean[ch][slot]);
+    }
+    tierAdvance(tier, acc.startMs);
+    accReset(acc);
+
+    if(++next.samples >= HISTORY_T2_FACTOR) {
+        closeT2();
+    }
+}
+
+static void pushSample(const uint8_t* raw, unsigned long timeMs) {
+    HistoryTier& tier = historyTiers[0];
+    HistoryAccumulator& acc = historyAcc[0];
+
+    if(acc.samples == 0) acc.startMs = timeMs;
+    for(uint8_t ch = 0; ch < HIST_CHANNEL_COUNT; ch++) {
+        historyT0[ch][tier.head] = raw[ch];
+        accAdd(acc, ch, raw[ch], raw[ch], raw[ch]);
+    }
+    tierAdvance(tier, timeMs);
+
+    if(++acc.samples >= HISTORY_T1_FACTOR) {
+        closeT1();
+    }
+}
+
+// ========== GAP (loop macet) ==========
+// Fungsi: Isi n slot NODATA ke satu tier mulai startMs. Maksimal len slot ditulis,
+// sisanya hanya memajukan head, jadi gap sepanjang apa pun O(len).
+static void tierFillNoData(uint8_t t, unsigned long n, unsigned long startMs) {
+    if(n == 0) return;
+    HistoryTier& tier = historyTiers[t];
+    unsigned long writes = (n > tier.len) ? tier.len : n;
+    tier.head = (uint16_t)((tier.head + (n - writes)) % tier.len);
+
+    for(unsigned long i = 0; i < writes; i++) {
+        uint16_t slot = tier.head;
+        for(uint8_t ch = 0; ch < HIST_CHANNEL_COUNT; ch++) {
+            if(t == 0) {
+                historyT0[ch][slot] = HISTORY_NODATA;
+            } else if(t == 1) {
+                historyT1Min[ch][slot] = historyT1Max[ch][slot] = historyT1Mean[ch][slot] = HISTORY_NODATA;
+            } else {
+                historyT2Min[ch][slot] = historyT2Max[ch][slot] = historyT2Mean[ch][slot] = HISTORY_NODATA;
+            }
+        }
+        tier.head = (tier.head + 1 == tier.len) ? 0 : tier.head + 1;
+    }
+
+    tier.count = (tier.count + n >= tier.len) ? tier.len : (uint16_t)(tier.count + n);
+    tier.lastTimeMs = startMs + (n - 1) * tier.period;
+}
+
+// Fungsi: Satu bucket T1 kosong (T0 ikut NODATA), ditutup lewat jalur normal
+static void skipT1Bucket(unsigned long startMs) {
+    tierFillNoData(0, HISTORY_T1_FACTOR, startMs);
+    historyAcc[0].startMs = startMs;
+    closeT1();
+}
+
+// Fungsi: Lewati missed slot T0 mulai historyNextSampleMs. Semua tier tetap
+// bersambung (waktu bucket = lastTimeMs - a * period tetap benar) tanpa push
+// sample satu per satu untuk gap berjam-jam.
+static void skipMissedSamples(unsigned long missed) {
+    uint8_t nodata[HIST_CHANNEL_COUNT];
+    memset(nodata, HISTORY_NODATA, sizeof(nodata));
+    const unsigned long t1Period = historyTiers[1].period;
+    const unsigned long t2Period = historyTiers[2].period;
+
+    // Selesaikan bucket T1 yang sedang berjalan
+    while(missed > 0 && historyAcc[0].samples != 0) {
+        pushSample(nodata, historyNextSampleMs);
+        historyNextSampleMs += HISTORY_T0_PERIOD_MS;
+        missed--;
+    }
+
+    unsigned long t1Buckets = missed / HISTORY_T1_FACTOR;
+    missed %= HISTORY_T1_FACTOR;
+
+    // Selesaikan bucket T2 yang sedang berjalan
+    while(t1Buckets > 0 && historyAcc[1].samples != 0) {
+        skipT1Bucket(historyNextSampleMs);
+        historyNextSampleMs += t1Period;
+        t1Buckets--;
+    }
+
+    // Bucket T2 utuh: isi langsung ketiga tier
+    unsigned long t2Buckets = t1Buckets / HISTORY_T2_FACTOR;
+    t1Buckets %= HISTORY_T2_FACTOR;
+    if(t2Buckets > 0) {
+        tierFillNoData(0, t2Buckets * HISTORY_T2_FACTOR * HISTORY_T1_FACTOR, historyNextSampleMs);
+        tierFillNoData(1, t2Buckets * HISTORY_T2_FACTOR, historyNextSampleMs);
+        tierFillNoData(2, t2Buckets, historyNextSampleMs);
+        historyNextSampleMs += t2Buckets * t2Period;
+    }
+
+    while(t1Buckets > 0) {
+        skipT1Bucket(historyNextSampleMs);
+        historyNextSampleMs += t1Period;
+        t1Buckets--;
+    }
+
+    while(missed > 0) {
+        pushSample(nodata, historyNextSampleMs);
+        historyNextSampleMs += HISTORY_T0_PERIOD_MS;
+        missed--;
+    }
+}
+
+// ========== FUNGSI PUBLIK ==========
+void foxHistoryClear() {
+    for(uint8_t t = 0; t < HISTORY_TIERS; t++) {
+        historyTiers[t].head = 0;
+        historyTiers[t].count = 0;
+        historyTiers[t].lastTimeMs = 0;
+    }
+    for(uint8_t a = 0; a < HISTORY_TIERS - 1; a++) {
+        accReset(historyAcc[a]);
+    }
+    historyNextSampleMs = millis();
+}
+
+void foxHistoryInit() {
+    foxHistoryClear();
+    Serial.print("History: ");
+    Serial.print(foxHistoryMemoryUsage() / 1024);
+    Serial.println(" KB");
+}
+
+// Dipanggil dari loop(), sample diambil tiap HISTORY_T0_PERIOD_MS
+void foxHistoryUpdate() {
+    unsigned long now = millis();
+    if((long)(now - historyNextSampleMs) < 0) return;
+
+    // Loop sempat macet: slot yang terlewat diisi NODATA di semua tier supaya waktu tier tetap lurus
+    unsigned long missed = (now - historyNextSampleMs) / HISTORY_T0_PERIOD_MS;
+    if(missed > 0) {
+        skipMissedSamples(missed);
+    }
+
+    const FoxVehicleData& data = foxVehicleGetDataRef();
+    uint8_t raw[HIST_CHANNEL_COUNT];
+    for(uint8_t ch = 0; ch < HIST_CHANNEL_COUNT; ch++) {
+        raw[ch] = foxSignalValid(data, historyEncoding[ch].signal)
+                  ? encodeValue(ch, channelValue(data, ch))
+                  : HISTORY_NODATA;
+    }
+    pushSample(raw, historyNextSampleMs);
+    historyNextSampleMs += HISTORY_T0_PERIOD_MS;
+}
+
+unsigned long foxHistoryGetPeriod(FoxHistoryResolution resolution) {
+    if(resolution >= HISTORY_TIERS) return 0;
+    return historyTiers[resolution].period;
+}
+
+// Fungsi: Tier paling halus yang masih menyimpan data sejak fromMs
+static FoxHistoryResolution pickResolution(unsigned long fromMs) {
+    for(uint8_t t = 0; t < HISTORY_TIERS; t++) {
+        const HistoryTier& tier = historyTiers[t];
+        if(tier.count < tier.len) return (FoxHistoryResolution)t;   // Belum wrap, semua masih ada
+        unsigned long oldest = tier.lastTimeMs - (unsigned long)(tier.count - 1) * tier.period;
+        if((long)(fromMs - oldest) >= 0) return (FoxHistoryResolution)t;
+    }
+    return HISTORY_RES_5MIN;
+}
+
+// Bucket dengan waktu awal di [fromMs, toMs], urut dari yang terlama.
+// Bucket T1/T2 yang masih berjalan belum ikut (baru muncul setelah ditutup).
+uint16_t foxHistoryQuery(FoxHistoryChannel channel, FoxHistoryResolution resolution,
+                         unsigned long fromMs, unsigned long toMs,
+                         FoxHistoryPoint* out, uint16_t maxPoints) {
+    if(channel >= HIST_CHANNEL_COUNT || out == NULL || maxPoints == 0) return 0;
+    if(resolution == HISTORY_RES_AUTO) resolution = pickResolution(fromMs);
+    if(resolution >= HISTORY_TIERS) return 0;
+
+    const HistoryTier& tier = historyTiers[resolution];
+    if(tier.count == 0 || (long)(tier.lastTimeMs - fromMs) < 0) return 0;
+
+    // Lompat langsung ke bucket pertama >= fromMs
+    unsigned long span = (tier.lastTimeMs - fromMs) / tier.period;
+    uint16_t age = (span >= tier.count) ? tier.count - 1 : (uint16_t)span;
+
+    const uint8_t* minRow = NULL;
+    const uint8_t* maxRow = NULL;
+    const uint8_t* meanRow = NULL;
+    if(resolution == HISTORY_RES_100MS) {
+        minRow = maxRow = meanRow = historyT0[channel];
+    } else if(resolution == HISTORY_RES_1S) {
+        minRow = historyT1Min[channel];
+        maxRow = historyT1Max[channel];
+        meanRow = historyT1Mean[channel];
+    } else {
+        minRow = historyT2Min[channel];
+        maxRow = historyT2Max[channel];
+        meanRow = historyT2Mean[channel];
+    }
+
+    uint16_t n = 0;
+    for(int32_t a = age; a >= 0 && n < maxPoints; a--) {
+        unsigned long t = tier.lastTimeMs - (unsigned long)a * tier.period;
+        if((long)(toMs - t) < 0) break;
+
+        uint16_t idx = (uint16_t)((tier.head + tier.len - 1 - a) % tier.len);
+        FoxHistoryPoint& p = out[n++];
+        p.timeMs = t;
+        p.valid = (meanRow[idx] != HISTORY_NODATA);
+        if(p.valid) {
+            p.min = decodeValue(channel, minRow[idx]);
+            p.max = decodeValue(channel, maxRow[idx]);
+            p.mean = decodeValue(channel, meanRow[idx]);
+        } else {
+            p.min = p.max = p.mean = 0.0f;
+        }
+    }
+    return n;
+}
+
+const char* foxHistoryChannelName(FoxHistoryChannel channel) {
+    switch(channel) {
+        case HIST_SPEED: return "SPEED";
+        case HIST_RPM: return "RPM";
+        case HIST_CURRENT: return "CURRENT";
+        case HIST_VOLTAGE: return "VOLTAGE";
+        case HIST_SOC: return "SOC";
+        case HIST_TEMP_CONTROLLER: return "TEMP_ECU";
+        case HIST_TEMP_MOTOR: return "TEMP_MOTOR";
+        case HIST_TEMP_BATTERY: return "TEMP_BATT";
+        default: return "UNKNOWN";
+    }
+}
+
+size_t foxHistoryMemoryUsage() {
+    return sizeof(historyT0) +
+           sizeof(historyT1Min) + sizeof(historyT1Max) + sizeof(historyT1Mean) +
+           sizeof(historyT2Min) + sizeof(historyT2Max) + sizeof(historyT2Mean) +
+           sizeof(historyTiers) + sizeof(historyAcc);
+}
+
+// Status tier + ringkasan 1 menit terakhir tiap channel
+void foxHistoryPrintStatus() {
+    static const char* tierNames[HISTORY_TIERS] = {"100ms", "1s", "5min"};
+
+    Serial.println("=== HISTORY ===");
+    Serial.printf("Memory: %u bytes\n", (unsigned)foxHistoryMemoryUsage());
+    for(uint8_t t = 0; t < HISTORY_TIERS; t++) {
+        const HistoryTier& tier = historyTiers[t];
+        Serial.printf("Tier %-5s: %u/%u buckets (%lu s)\n", tierNames[t], tier.count, tier.len,
+                      (unsigned long)tier.count * tier.period / 1000);
+    }
+
+    FoxHistoryPoint points[60];
+    unsigned long now = millis();
+    Serial.println("Last 60 s       MIN     MAX    MEAN");
+    for(uint8_t ch = 0; ch < HIST_CHANNEL_COUNT; ch++) {
+        uint16_t n = foxHistoryQuery((FoxHistoryChannel)ch, HISTORY_RES_1S, now - 60000UL, now, points, 60);
+        float mn = 0, mx = 0, sum = 0;
+        uint16_t valid = 0;
+        for(uint16_t i = 0; i < n; i++) {
+            if(!points[i].valid) continue;
+            if(valid == 0 || points[i].min < mn) mn = points[i].min;
+            if(valid == 0 || points[i].max > mx) mx = points[i].max;
+            sum += points[i].mean;
+            valid++;
+        }
+        Serial.printf("%-12s", foxHistoryChannelName((FoxHistoryChannel)ch));
+        if(valid == 0) {
+            Serial.println("      --      --      --");
+        } else {
+            Serial.printf(" %7.1f %7.1f %7.1f\n", mn, mx, sum / valid);
+        }
+    }
+    Serial.println("===============");
+}
@@ -0,0 +1,47 @@
+#ifndef FOX_HISTORY_H
+#define FOX_HISTORY_H
+
+#include <Arduino.h>
+
+// Channel yang direkam dari FoxVehicleData
+enum FoxHistoryChannel {
+    HIST_SPEED = 0,
+    HIST_RPM,
+    HIST_CURRENT,
+    HIST_VOLTAGE,
+    HIST_SOC,
+    HIST_TEMP_CONTROLLER,
+    HIST_TEMP_MOTOR,
+    HIST_TEMP_BATTERY,
+    HIST_CHANNEL_COUNT
+};
+
+// Resolusi = tier ring buffer. AUTO memilih tier paling halus yang masih mencakup fromMs.
+enum FoxHistoryResolution {
+    HISTORY_RES_100MS = 0,
+    HISTORY_RES_1S,
+    HISTORY_RES_5MIN,
+    HISTORY_RES_AUTO
+};
+
+// Satu titik hasil query. Tier 0 hanya punya satu nilai (min = max = mean).
+struct FoxHistoryPoint {
+    unsigned long timeMs;       // millis() awal bucket
+    float min;
+    float max;
+    float mean;
+    bool valid;                 // false = signal stale / belum ada data di bucket ini
+};
+
+void foxHistoryInit();
+void foxHistoryUpdate();
+void foxHistoryClear();
+uint16_t foxHistoryQuery(FoxHistoryChannel channel, FoxHistoryResolution resolution,
+                         unsigned long fromMs, unsigned long toMs,
+                         FoxHistoryPoint* out, uint16_t maxPoints);
+unsigned long foxHistoryGetPeriod(FoxHistoryResolution resolution);
+const char* foxHistoryChannelName(FoxHistoryChannel channel);
+size_t foxHistoryMemoryUsage();
+void foxHistoryPrintStatus();
+
+#endif
@@ -0,0 +1,323 @@
+#include "fox_i2c.h"
+#include "fox_config.h"
+#include <Wire.h>
+
+// ========== CLOCK ADAPTIF ==========
+// Clock per device naik satu step setelah I2C_ADAPT_CLEAN_WINDOWS window tanpa error,
+// turun satu step begitu error dalam window mencapai I2C_ADAPT_MAX_ERRORS.
+// Step yang gagal ditahan (tidak dicoba lagi) selama I2C_ADAPT_HOLD_MS.
+static const uint32_t i2cClockSteps[] = {50000, 100000, 400000, 1000000};
+#define I2C_CLOCK_STEP_COUNT (sizeof(i2cClockSteps) / sizeof(i2cClockSteps[0]))
+
+struct I2CDeviceState {
+    FoxI2CDeviceStats stats;
+    uint8_t clockStep;
+    uint8_t maxStep;            // Batas konfigurasi device
+    uint8_t holdStep;           // Batas sementara setelah fallback
+    bool holding;
+    unsigned long holdSinceMs;
+    uint16_t windowCount;
+    uint8_t windowErrors;
+    uint8_t cleanWindows;
+};
+
+I2CDeviceState i2cDevices[I2C_DEV_COUNT];
+uint32_t i2cBusClockHz = 0;     // Clock yang terpasang di Wire (0 = tidak diketahui)
+volatile bool i2cOffline = false;
+
+#ifdef ESP32
+SemaphoreHandle_t i2cMutex = NULL;
+portMUX_TYPE i2cWaitMux = portMUX_INITIALIZER_UNLOCKED;
+volatile uint8_t i2cWaiting[I2C_PRIO_COUNT];
+#endif
+
+static uint8_t clockStepFor(uint32_t hz) {
+    uint8_t step = 0;
+    for(uint8_t i = 0; i < I2C_CLOCK_STEP_COUNT; i++) {
+        if(i2cClockSteps[i] <= hz) step = i;
+    }
+    return step;
+}
+
+static void initDevice(FoxI2CDevice dev, uint8_t address, uint32_t maxClockHz) {
+    I2CDeviceState& d = i2cDevices[dev];
+    memset(&d, 0, sizeof(d));
+    d.maxStep = clockStepFor(maxClockHz);
+    d.clockStep = clockStepFor(I2C_CLOCK_START_HZ);
+    if(d.clockStep > d.maxStep) d.clockStep = d.maxStep;
+    d.stats.address = address;
+    d.stats.clockHz = i2cClockSteps[d.clockStep];
+}
+
+static void adaptClock(I2CDeviceState& d, bool error, unsigned long now) {
+    d.windowCount++;
+    if(error) d.windowErrors++;
+
+    if(d.windowErrors >= I2C_ADAPT_MAX_ERRORS) {
+        // Fallback langsung, tidak menunggu window penuh
+        if(d.clockStep > 0) {
+            d.clockStep--;
+            d.holdStep = d.clockStep;
+            d.holding = true;
+            d.holdSinceMs = now;
+            d.stats.clockDowngrades++;
+        }
+        d.windowCount = 0;
+        d.windowErrors = 0;
+        d.cleanWindows = 0;
+        return;
+    }
+    if(d.windowCount < I2C_ADAPT_WINDOW) return;
+
+    bool clean = (d.windowErrors == 0);
+    d.windowCount = 0;
+    d.windowErrors = 0;
+    if(!clean) {
+        d.cleanWindows = 0;
+        return;
+    }
+    if(++d.cleanWindows < I2C_ADAPT_CLEAN_WINDOWS) return;
+    d.cleanWindows = 0;
+
+    if(d.holding && now - d.holdSinceMs >= I2C_ADAPT_HOLD_MS) {
+        d.holding = false;
+    }
+    uint8_t ceiling = d.holding ? d.holdStep : d.maxStep;
+    if(d.clockStep < ceiling) {
+        d.clockStep++;
+        d.stats.clockUpgrades++;
+    }
+}
+
+// ========== ARBITRASI BUS ==========
+// Mutex dilepas setiap akhir transaksi. Pengambil prioritas rendah yang mendapat
+// mutex saat ada prioritas lebih tinggi menunggu mengembalikannya dulu, jadi
+// baca RTC tidak menunggu seluruh frame OLED, paling lama satu chunk.
+#ifdef ESP32
+static bool higherWaiting(FoxI2CPriority prio) {
+    for(uint8_t p = prio + 1; p < I2C_PRIO_COUNT; p++) {
+        if(i2cWaiting[p] > 0) return true;
+    }
+    return false;
+}
+#endif
+
+static void lockBus(FoxI2CPriority prio) {
+#ifdef ESP32
+    if(i2cMutex == NULL) return;
+    portENTER_CRITICAL(&i2cWaitMux);
+    i2cWaiting[prio]++;
+    portEXIT_CRITICAL(&i2cWaitMux);
+
+    for(;;) {
+        xSemaphoreTake(i2cMutex, portMAX_DELAY);
+        if(!higherWaiting(prio)) break;
+        xSemaphoreGive(i2cMutex);
+        vTaskDelay(1);
+    }
+
+    portENTER_CRITICAL(&i2cWaitMux);
+    i2cWaiting[prio]--;
+    portEXIT_CRITICAL(&i2cWaitMux);
+#endif
+}
+
+static void unlockBus() {
+#ifdef ESP32
+    if(i2cMutex != NULL) xSemaphoreGive(i2cMutex);
+#endif
+}
+
+// ========== TRANSAKSI ==========
+static void applyClock(uint32_t hz) {
+    if(i2cBusClockHz == hz) return;
+    Wire.setClock(hz);
+    i2cBusClockHz = hz;
+}
+
+// Catat hasil transaksi, dipanggil sambil memegang bus
+static void recordTransaction(FoxI2CDevice dev, uint8_t result, size_t bytes,
+                              uint32_t waitUs, uint32_t latencyUs) {
+    I2CDeviceState& d = i2cDevices[dev];
+    FoxI2CDeviceStats& s = d.stats;
+    unsigned long now = millis();
+
+    s.transactions++;
+    s.lastLatencyUs = latencyUs;
+    s.avgLatencyUs = (s.transactions == 1) ? latencyUs
+                     : s.avgLatencyUs + ((int32_t)(latencyUs - s.avgLatencyUs) >> 3);
+    if(latencyUs > s.maxLatencyUs) s.maxLatencyUs = latencyUs;
+    if(waitUs > s.maxWaitUs) s.maxWaitUs = waitUs;
+
+    switch(result) {
+        case I2C_OK:
+            s.bytes += bytes;
+            s.lastOkMs = now;
+            s.consecutiveErrors = 0;
+            break;
+        case I2C_ERR_NACK_ADDR:
+        case I2C_ERR_NACK_DATA:
+            s.nacks++;
+            break;
+        case I2C_ERR_TIMEOUT:
+            s.timeouts++;
+            break;
+        default:
+            s.otherErrors++;
+            break;
+    }
+    if(result != I2C_OK) {
+        s.lastErrorMs = now;
+        if(s.consecutiveErrors < UINT16_MAX) s.consecutiveErrors++;
+    }
+
+    // Data terlalu panjang = bug pemanggil, bukan kualitas bus
+    if(result != I2C_ERR_DATA_TOO_LONG) {
+        adaptClock(d, result != I2C_OK, now);
+        s.clockHz = i2cClockSteps[d.clockStep];
+    }
+}
+
+static uint8_t runTransaction(FoxI2CDevice dev, FoxI2CPriority prio, bool hasPrefix, uint8_t prefix,
+                              const uint8_t* data, size_t len, uint8_t* out, size_t outLen) {
+    uint32_t waitStart = micros();
+    lockBus(prio);
+    if(i2cOffline) {
+        unlockBus();
+        return I2C_ERR_BUS_OFFLINE;
+    }
+    uint32_t start = micros();
+
+    I2CDeviceState& d = i2cDevices[dev];
+    applyClock(i2cClockSteps[d.clockStep]);
+
+    Wire.beginTransmission(d.stats.address);
+    if(hasPrefix) Wire.write(prefix);
+    if(len > 0) Wire.write(data, len);
+    uint8_t result = Wire.endTransmission(outLen == 0);
+
+    if(result == I2C_OK && outLen > 0) {
+        size_t got = Wire.requestFrom(d.stats.address, (uint8_t)outLen);
+        for(size_t i = 0; i < got && i < outLen; i++) {
+            out[i] = Wire.read();
+        }
+        if(got != outLen) result = I2C_ERR_SHORT_READ;
+    }
+
+    uint32_t end = micros();
+    recordTransaction(dev, result, (hasPrefix ? 1 : 0) + len + outLen, start - waitStart, end - start);
+    unlockBus();
+    return result;
+}
+
+// ========== FUNGSI PUBLIK ==========
+void foxI2CInit() {
+    initDevice(I2C_DEV_OLED, OLED_ADDRESS, I2C_OLED_MAX_CLOCK_HZ);
+    initDevice(I2C_DEV_RTC, RTC_I2C_ADDRESS, I2C_RTC_MAX_CLOCK_HZ);
+
+#ifdef ESP32
+    if(i2cMutex == NULL) {
+        i2cMutex = xSemaphoreCreateMutex();
+        if(i2cMutex == NULL) {
+            Serial.println("I2C: gagal membuat mutex, bus tanpa arbitrasi");
+        }
+    }
+#endif
+
+    Wire.begin(SDA_PIN, SCL_PIN);
+#ifdef ESP32
+    Wire.setTimeOut(I2C_TIMEOUT_MS);
+#endif
+    i2cBusClockHz = 0;
+    applyClock(i2cClockSteps[clockStepFor(I2C_CLOCK_START_HZ)]);
+}
+
+void foxI2CSetAddress(FoxI2CDevice dev, uint8_t address) {
+    lockBus(I2C_PRIO_NORMAL);
+    i2cDevices[dev].stats.address = address;
+    unlockBus();
+}
+
+uint8_t foxI2CWrite(FoxI2CDevice dev, FoxI2CPriority prio, uint8_t prefix,
+                    const uint8_t* data, size_t len) {
+    return runTransaction(dev, prio, true, prefix, data, len, NULL, 0);
+}
+
+uint8_t foxI2CRead(FoxI2CDevice dev, FoxI2CPriority prio, uint8_t reg, uint8_t* out, size_t len) {
+    return runTransaction(dev, prio, true, reg, NULL, 0, out, len);
+}
+
+uint8_t foxI2CProbe(FoxI2CDevice dev, FoxI2CPriority prio) {
+    return runTransaction(dev, prio, false, 0, NULL, 0, NULL, 0);
+}
+
+void foxI2CAcquire(FoxI2CPriority prio) {
+    lockBus(prio);
+}
+
+void foxI2CRelease() {
+    // Library (Adafruit) bisa mengganti clock sendiri
+    i2cBusClockHz = 0;
+    unlockBus();
+}
+
+void foxI2CRestart() {
+    Wire.begin(SDA_PIN, SCL_PIN);
+#ifdef ESP32
+    Wire.setTimeOut(I2C_TIMEOUT_MS);
+#endif
+    i2cBusClockHz = 0;
+    // Sesi bus baru: error sebelum recovery tidak dihitung lagi
+    for(uint8_t i = 0; i < I2C_DEV_COUNT; i++) {
+        i2cDevices[i].stats.consecutiveErrors = 0;
+    }
+}
+
+void foxI2CSetOffline(bool offline) {
+    i2cOffline = offline;
+}
+
+uint16_t foxI2CConsecutiveErrors(FoxI2CDevice dev) {
+    return i2cDevices[dev].stats.consecutiveErrors;
+}
+
+FoxI2CDeviceStats foxI2CGetStats(FoxI2CDevice dev) {
+    lockBus(I2C_PRIO_HIGH);
+    FoxI2CDeviceStats stats = i2cDevices[dev].stats;
+    unlockBus();
+    return stats;
+}
+
+void foxI2CResetStats() {
+    lockBus(I2C_PRIO_HIGH);
+    for(uint8_t i = 0; i < I2C_DEV_COUNT; i++) {
+        FoxI2CDeviceStats& s = i2cDevices[i].stats;
+        uint8_t address = s.address;
+        uint32_t clockHz = s.clockHz;
+        memset(&s, 0, sizeof(s));
+        s.address = address;
+        s.clockHz = clockHz;
+    }
+    unlockBus();
+}
+
+void foxI2CPrintStatus() {
+    static const char* names[I2C_DEV_COUNT] = {"OLED", "RTC"};
+
+    Serial.println("=== I2C BUS ===");
+    for(uint8_t i = 0; i < I2C_DEV_COUNT; i++) {
+        FoxI2CDeviceStats s = foxI2CGetStats((FoxI2CDevice)i);
+        Serial.printf("%-4s 0x%02X @ %lu kHz (down %u, up %u)\n", names[i], s.address,
+                      (unsigned long)(s.clockHz / 1000), s.clockDowngrades, s.clockUpgrades);
+        Serial.printf("  %lu transaksi, %lu byte, error: %lu NACK, %lu timeout, %lu lain\n",
+                      (unsigned long)s.transactions, (unsigned long)s.bytes, (unsigned long)s.nacks,
+                      (unsigned long)s.timeouts, (unsigned long)s.otherErrors);
+        Serial.printf("  latency last %lu us, avg %lu us, max %lu us, max wait %lu us\n",
+                      (unsigned long)s.lastLatencyUs, (unsigned long)s.avgLatencyUs,
+                      (unsigned long)s.maxLatencyUs, (unsigned long)s.maxWaitUs);
+        if(s.lastErrorMs > 0) {
+            Serial.printf("  error terakhir %lu s lalu\n", (millis() - s.lastErrorMs) / 1000);
+        }
+    }
+    Serial.println("===============");
+}
@@ -0,0 +1,77 @@
+#ifndef FOX_I2C_H
+#define FOX_I2C_H
+
+#include <Arduino.h>
+
+// Device di bus I2C bersama (SDA_PIN/SCL_PIN)
+enum FoxI2CDevice {
+    I2C_DEV_OLED = 0,
+    I2C_DEV_RTC,
+    I2C_DEV_COUNT
+};
+
+// Prioritas transaksi. Bus dibagi per transaksi: transaksi BULK (data frame OLED)
+// mengalah selama ada transaksi prioritas lebih tinggi yang menunggu.
+enum FoxI2CPriority {
+    I2C_PRIO_BULK = 0,          // Chunk data frame OLED
+    I2C_PRIO_NORMAL,            // Command, probe, setting RTC
+    I2C_PRIO_HIGH,              // Baca RTC
+    I2C_PRIO_COUNT
+};
+
+// Hasil transaksi: kode Wire.endTransmission() + short read
+#define I2C_OK 0
+#define I2C_ERR_DATA_TOO_LONG 1
+#define I2C_ERR_NACK_ADDR 2
+#define I2C_ERR_NACK_DATA 3
+#define I2C_ERR_OTHER 4
+#define I2C_ERR_TIMEOUT 5
+#define I2C_ERR_SHORT_READ 6    // requestFrom() menerima kurang dari yang diminta
+#define I2C_ERR_BUS_OFFLINE 7   // Bus sedang di-recovery, transaksi tidak dijalankan
+
+// Statistik per device (hanya transaksi lewat foxI2CWrite/Read/Probe)
+struct FoxI2CDeviceStats {
+    uint8_t address;
+    uint32_t clockHz;           // Clock device saat ini (hasil adaptasi)
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t nacks;
+    uint32_t timeouts;
+    uint32_t otherErrors;
+    uint32_t lastLatencyUs;     // Durasi transaksi di bus, tanpa waktu tunggu arbitrasi
+    uint32_t avgLatencyUs;      // Rata-rata bergerak (1/8)
+    uint32_t maxLatencyUs;
+    uint32_t maxWaitUs;         // Terlama menunggu giliran bus
+    uint16_t clockDowngrades;
+    uint16_t clockUpgrades;
+    uint16_t consecutiveErrors; // Direset transaksi sukses dan foxI2CRestart()
+    unsigned long lastOkMs;
+    unsigned long lastErrorMs;
+};
+
+void foxI2CInit();
+void foxI2CSetAddress(FoxI2CDevice dev, uint8_t address);
+
+// Satu transaksi: prefix (control byte OLED / register RTC) lalu data
+uint8_t foxI2CWrite(FoxI2CDevice dev, FoxI2CPriority prio, uint8_t prefix,
+                    const uint8_t* data, size_t len);
+// Tulis register lalu baca len byte (repeated start)
+uint8_t foxI2CRead(FoxI2CDevice dev, FoxI2CPriority prio, uint8_t reg, uint8_t* out, size_t len);
+uint8_t foxI2CProbe(FoxI2CDevice dev, FoxI2CPriority prio);
+
+// Akses Wire langsung (library Adafruit, recovery bus). Transaksi di antaranya
+// tidak tercatat; clock diterapkan ulang pada transaksi berikutnya.
+void foxI2CAcquire(FoxI2CPriority prio);
+void foxI2CRelease();
+// Wire.begin() ulang setelah Wire.end(), dipanggil sambil memegang bus
+void foxI2CRestart();
+// Selama offline transaksi langsung gagal (I2C_ERR_BUS_OFFLINE) tanpa menyentuh Wire
+void foxI2CSetOffline(bool offline);
+// Health pasif dari transfer nyata, tanpa lock (aman dipanggil tiap loop)
+uint16_t foxI2CConsecutiveErrors(FoxI2CDevice dev);
+
+FoxI2CDeviceStats foxI2CGetStats(FoxI2CDevice dev);
+void foxI2CResetStats();
+void foxI2CPrintStatus();
+
+#endif
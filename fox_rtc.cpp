@@ -1,9 +1,9 @@
 #include "fox_rtc.h"
 #include "fox_config.h"
-#include <Wire.h>
+#include "fox_i2c.h"
+#include "fox_format.h"
 
-// Register addresses untuk DS3231
-#define DS3231_ADDRESS 0x68
+// Register addresses untuk DS3231 (alamat bus: RTC_I2C_ADDRESS, lewat fox_i2c)
 #define DS3231_TIME_REG 0x00
 #define DS3231_CONTROL_REG 0x0E
 #define DS3231_TEMP_REG 0x11
@@ -19,18 +19,12 @@ static uint8_t decToBcd(uint8_t val) {
 }
 
 bool foxRTCInit() {  // RENAME: initRTC() -> foxRTCInit()
-    Wire.beginTransmission(DS3231_ADDRESS);
-    if (Wire.endTransmission() == 0) {
+    if (foxI2CProbe(I2C_DEV_RTC, I2C_PRIO_NORMAL) == I2C_OK) {
         Serial.println("RTC DS3231 terdeteksi");
         
         // Cek jika RTC berjalan
-        Wire.beginTransmission(DS3231_ADDRESS);
-        Wire.write(DS3231_CONTROL_REG);
-        Wire.endTransmission();
-        
-        Wire.requestFrom(DS3231_ADDRESS, 1);
-        if (Wire.available()) {
-            uint8_t status = Wire.read();
+        uint8_t status;
+        if (foxI2CRead(I2C_DEV_RTC, I2C_PRIO_NORMAL, DS3231_CONTROL_REG, &status, 1) == I2C_OK) {
             if (!(status & 0x80)) {
                 Serial.println("RTC berjalan normal");
             } else {
@@ -48,20 +42,17 @@ bool foxRTCInit() {  // RENAME: initRTC() -> foxRTCInit()
 
 RTCDateTime foxRTCGetDateTime() {  // RENAME: getRTC() -> foxRTCGetDateTime()
     RTCDateTime dt;
-    
-    Wire.beginTransmission(DS3231_ADDRESS);
-    Wire.write(DS3231_TIME_REG);
-    Wire.endTransmission();
-    
-    Wire.requestFrom(DS3231_ADDRESS, 7);
-    if (Wire.available() == 7) {
-        uint8_t seconds = bcdToDec(Wire.read() & 0x7F);
-        uint8_t minutes = bcdToDec(Wire.read());
-        uint8_t hours = bcdToDec(Wire.read() & 0x3F); // 24h mode
-        uint8_t dayOfWeek = bcdToDec(Wire.read());
-        uint8_t day = bcdToDec(Wire.read());
-        uint8_t month = bcdToDec(Wire.read() & 0x1F); // Mask century bit
-        uint16_t year = bcdToDec(Wire.read()) + 2000;
+    uint8_t raw[7];
+    
+    // Prioritas tinggi: menyela transfer frame OLED di antara chunk
+    if (foxI2CRead(I2C_DEV_RTC, I2C_PRIO_HIGH, DS3231_TIME_REG, raw, sizeof(raw)) == I2C_OK) {
+        uint8_t seconds = bcdToDec(raw[0] & 0x7F);
+        uint8_t minutes = bcdToDec(raw[1]);
+        uint8_t hours = bcdToDec(raw[2] & 0x3F); // 24h mode
+        uint8_t dayOfWeek = bcdToDec(raw[3]);
+        uint8_t day = bcdToDec(raw[4]);
+        uint8_t month = bcdToDec(raw[5] & 0x1F); // Mask century bit
+        uint16_t year = bcdToDec(raw[6]) + 2000;
         
         dt.second = seconds;
         dt.minute = minutes;
@@ -110,24 +101,20 @@ void foxRTCSetTime(uint16_t year, uint8_t month, uint8_t day,
         dayOfWeek = 1;  // Fallback ke Senin
     }
     
-    Wire.beginTransmission(DS3231_ADDRESS);
-    Wire.write(DS3231_TIME_REG);
-    
-    Wire.write(decToBcd(second));
-    Wire.write(decToBcd(minute));
-    Wire.write(decToBcd(hour));      // 24h mode
-    Wire.write(decToBcd(dayOfWeek)); // DAY OF WEEK
-    Wire.write(decToBcd(day));
-    Wire.write(decToBcd(month));     // No century bit
-    Wire.write(decToBcd(year2digit));
-    
-    Wire.endTransmission();
+    uint8_t raw[7] = {
+        decToBcd(second),
+        decToBcd(minute),
+        decToBcd(hour),         // 24h mode
+        decToBcd(dayOfWeek),    // DAY OF WEEK
+        decToBcd(day),
+        decToBcd(month),        // No century bit
+        decToBcd(year2digit)
+    };
+    foxI2CWrite(I2C_DEV_RTC, I2C_PRIO_NORMAL, DS3231_TIME_REG, raw, sizeof(raw));
     
     // Clear OSF flag
-    Wire.beginTransmission(DS3231_ADDRESS);
-    Wire.write(DS3231_CONTROL_REG);
-    Wire.write(0x00);  // Clear all control bits
-    Wire.endTransmission();
+    const uint8_t control = 0x00;  // Clear all control bits
+    foxI2CWrite(I2C_DEV_RTC, I2C_PRIO_NORMAL, DS3231_CONTROL_REG, &control, 1);
     
     // Tampilkan log
     const char* hari[] = {"MINGGU", "SENIN", "SELASA", "RABU", 
@@ -171,14 +158,10 @@ void foxRTCSetFromCompileTime() {  // RENAME: setRTCFromCompileTime() -> foxRTCS
 }
 
 float foxRTCGetTemperature() {  // RENAME: getTemperature() -> foxRTCGetTemperature()
-    Wire.beginTransmission(DS3231_ADDRESS);
-    Wire.write(DS3231_TEMP_REG);
-    Wire.endTransmission();
-    
-    Wire.requestFrom(DS3231_ADDRESS, 2);
-    if (Wire.available() == 2) {
-        uint8_t temp_msb = Wire.read();
-        uint8_t temp_lsb = Wire.read();
+    uint8_t raw[2];
+    if (foxI2CRead(I2C_DEV_RTC, I2C_PRIO_HIGH, DS3231_TEMP_REG, raw, sizeof(raw)) == I2C_OK) {
+        uint8_t temp_msb = raw[0];
+        uint8_t temp_lsb = raw[1];
         
         // Convert to temperature (℃)
         float temp = temp_msb + ((temp_lsb >> 6) * 0.25);
@@ -188,62 +171,55 @@ float foxRTCGetTemperature() {  // RENAME: getTemperature() -> foxRTCGetTemperat
 }
 
 bool foxRTCIsRunning() {  // RENAME: isRunning() -> foxRTCIsRunning()
-    Wire.beginTransmission(DS3231_ADDRESS);
-    Wire.write(DS3231_CONTROL_REG);
-    Wire.endTransmission();
-    
-    Wire.requestFrom(DS3231_ADDRESS, 1);
-    if (Wire.available()) {
-        uint8_t status = Wire.read();
+    uint8_t status;
+    if (foxI2CRead(I2C_DEV_RTC, I2C_PRIO_HIGH, DS3231_CONTROL_REG, &status, 1) == I2C_OK) {
         return !(status & 0x80); // OSF flag clear = running
     }
     return false;
 }
 
-String foxRTCGetTimeString(bool includeSeconds) {  // RENAME: getTimeString() -> foxRTCGetTimeString()
+const char* foxRTCGetTimeString(char* buffer, size_t size, bool includeSeconds) {  // RENAME: getTimeString() -> foxRTCGetTimeString()
     RTCDateTime dt = foxRTCGetDateTime();
-    
-    char buffer[9];
-    if(includeSeconds) {
-        snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d", 
-                 dt.hour, dt.minute, dt.second);
-    } else {
-        snprintf(buffer, sizeof(buffer), "%02d:%02d", 
-                 dt.hour, dt.minute);
-    }
-    
-    return String(buffer);
+    foxFormatTime(buffer, size, dt.hour, dt.minute, includeSeconds ? dt.second : -1);
+    return buffer;
 }
 
-String foxRTCGetDateString() {  // RENAME: getDateString() -> foxRTCGetDateString()
+const char* foxRTCGetDateString(char* buffer, size_t size) {  // RENAME: getDateString() -> foxRTCGetDateString()
     RTCDateTime dt = foxRTCGetDateTime();
-    
-    char buffer[11];
-    snprintf(buffer, sizeof(buffer), "%02d/%02d/%04d", 
-             dt.day, dt.month, dt.year);
-    
-    return String(buffer);
+    foxFormatDate(buffer, size, dt.day, dt.month, dt.year);
+    return buffer;
+}
+
+// Fungsi: Baca angka lalu separator (atau akhir string jika sep = 0)
+static const char* parseField(const char* p, uint32_t& value, char sep) {
+    if(p == NULL) return NULL;
+    p = foxParseUInt(p, value);
+    if(p == NULL || *p != sep) return NULL;
+    return sep ? p + 1 : p;
 }
 
-bool foxRTCSetTimeFromString(String timeStr) {  // RENAME: setTimeFromString() -> foxRTCSetTimeFromString()
+bool foxRTCSetTimeFromString(const char* timeStr) {  // RENAME: setTimeFromString() -> foxRTCSetTimeFromString()
     // Format: HH:MM:SS atau HH:MM
-    int hour, minute, second = 0;
+    uint32_t hour, minute, second = 0;
+    size_t len = strlen(timeStr);
     
-    if (timeStr.length() == 8) { // HH:MM:SS
-        if (sscanf(timeStr.c_str(), "%d:%d:%d", &hour, &minute, &second) != 3) {
+    if (len == 8) { // HH:MM:SS
+        const char* p = parseField(timeStr, hour, ':');
+        p = parseField(p, minute, ':');
+        if (parseField(p, second, 0) == NULL) {
             return false;
         }
-    } else if (timeStr.length() == 5) { // HH:MM
-        if (sscanf(timeStr.c_str(), "%d:%d", &hour, &minute) != 2) {
+    } else if (len == 5) { // HH:MM
+        const char* p = parseField(timeStr, hour, ':');
+        if (parseField(p, minute, 0) == NULL) {
             return false;
         }
-        second = 0;
     } else {
         return false;
     }
     
     // Validasi
-    if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59) {
+    if (hour > 23 || minute > 59 || second > 59) {
         return false;
     }
     
@@ -258,11 +234,13 @@ bool foxRTCSetTimeFromString(String timeStr) {  // RENAME: setTimeFromString() -
     return true;
 }
 
-bool foxRTCSetDateFromString(String dateStr) {  // RENAME: setDateFromString() -> foxRTCSetDateFromString()
+bool foxRTCSetDateFromString(const char* dateStr) {  // RENAME: setDateFromString() -> foxRTCSetDateFromString()
     // Format: DD/MM/YYYY
-    int day, month, year;
+    uint32_t day, month, year;
     
-    if (sscanf(dateStr.c_str(), "%d/%d/%d", &day, &month, &year) != 3) {
+    const char* p = parseField(dateStr, day, '/');
+    p = parseField(p, month, '/');
+    if (parseField(p, year, 0) == NULL) {
         return false;
     }
     
@@ -15,14 +15,15 @@ struct RTCDateTime {
 
 bool foxRTCInit();
 RTCDateTime foxRTCGetDateTime();
-String foxRTCGetTimeString(bool includeSeconds = true);
-String foxRTCGetDateString();
+// Tulis ke buffer pemanggil (min. 9 / 11 byte), return buffer
+const char* foxRTCGetTimeString(char* buffer, size_t size, bool includeSeconds = true);
+const char* foxRTCGetDateString(char* buffer, size_t size);
 void foxRTCSetTime(uint16_t year, uint8_t month, uint8_t day, 
                    uint8_t hour, uint8_t minute, uint8_t second,
                    uint8_t dayOfWeek = 0);
 void foxRTCSetFromCompileTime();
-bool foxRTCSetTimeFromString(String timeStr);
-bool foxRTCSetDateFromString(String dateStr);
+bool foxRTCSetTimeFromString(const char* timeStr);
+bool foxRTCSetDateFromString(const char* dateStr);
 bool foxRTCSetDayOfWeek(uint8_t dayOfWeek);
 float foxRTCGetTemperature();
 bool foxRTCIsRunning();
@@ -0,0 +1,159 @@
+#include "fox_sniffer.h"
+#include "fox_config.h"
+#include <Arduino.h>
+
+static_assert((SNIFFER_TABLE_SIZE & (SNIFFER_TABLE_SIZE - 1)) == 0, "SNIFFER_TABLE_SIZE harus pangkat 2");
+static_assert(SNIFFER_TABLE_SIZE <= 255, "Jumlah entry disimpan di uint8_t");
+
+// 0xFFFFFFFF tidak pernah dicatat (sama seperti filter capture lama), dipakai sebagai slot kosong
+#define SNIFFER_EMPTY_ID 0xFFFFFFFFUL
+
+FoxSnifferEntry snifferTable[SNIFFER_TABLE_SIZE];
+uint8_t snifferCount = 0;
+uint32_t snifferDropped = 0;
+bool snifferReady = false;
+
+// Hash ID 29-bit, bit rendah ID Votol sering sama sehingga perlu diacak dulu
+static inline uint32_t snifferHash(uint32_t canId) {
+    canId ^= canId >> 16;
+    canId *= 0x45D9F3BUL;
+    canId ^= canId >> 16;
+    return canId;
+}
+
+// Fungsi: Cari slot ID (linear probing), atau slot kosong pertama jika belum ada
+static FoxSnifferEntry* snifferFindSlot(uint32_t canId) {
+    uint32_t slot = snifferHash(canId) & (SNIFFER_TABLE_SIZE - 1);
+    for(uint16_t probe = 0; probe < SNIFFER_TABLE_SIZE; probe++) {
+        FoxSnifferEntry* e = &snifferTable[slot];
+        if(e->canId == canId || e->canId == SNIFFER_EMPTY_ID) {
+            return e;
+        }
+        slot = (slot + 1) & (SNIFFER_TABLE_SIZE - 1);
+    }
+    return NULL;
+}
+
+void foxSnifferReset() {
+    for(uint16_t i = 0; i < SNIFFER_TABLE_SIZE; i++) {
+        snifferTable[i].canId = SNIFFER_EMPTY_ID;
+    }
+    snifferCount = 0;
+    snifferDropped = 0;
+    snifferReady = true;
+}
+
+void foxSnifferRecord(uint32_t canId, const uint8_t* data, uint8_t len) {
+    if(canId == 0x00000000 || canId == SNIFFER_EMPTY_ID) return;
+    if(!snifferReady) foxSnifferReset();
+    if(len > 8) len = 8;
+
+    FoxSnifferEntry* e = snifferFindSlot(canId);
+    unsigned long now = millis();
+
+    if(e == NULL || (e->canId == SNIFFER_EMPTY_ID && snifferCount >= SNIFFER_TABLE_SIZE - 1)) {
+        // Sisakan satu slot kosong supaya probing selalu berhenti
+        snifferDropped++;
+        return;
+    }
+
+    if(e->canId == SNIFFER_EMPTY_ID) {
+        e->canId = canId;
+        e->frames = 0;
+        e->firstMs = now;
+        e->maxLen = 0;
+        memset(e->minData, 0xFF, sizeof(e->minData));
+        memset(e->maxData, 0x00, sizeof(e->maxData));
+        memset(e->toggled, 0x00, sizeof(e->toggled));
+        memcpy(e->lastData, data, len);
+        snifferCount++;
+    }
+
+    for(uint8_t i = 0; i < len; i++) {
+        uint8_t b = data[i];
+        if(i < e->maxLen) {
+            e->toggled[i] |= (uint8_t)(b ^ e->lastData[i]);
+        }
+        if(b < e->minData[i]) e->minData[i] = b;
+        if(b > e->maxData[i]) e->maxData[i] = b;
+        e->lastData[i] = b;
+    }
+    if(len > e->maxLen) e->maxLen = len;
+
+    e->len = len;
+    e->frames++;
+    e->lastMs = now;
+}
+
+uint8_t foxSnifferGetCount() {
+    return snifferCount;
+}
+
+uint32_t foxSnifferGetDropped() {
+    return snifferDropped;
+}
+
+bool foxSnifferGetEntry(uint32_t canId, FoxSnifferEntry& out) {
+    if(!snifferReady || canId == SNIFFER_EMPTY_ID) return false;
+    FoxSnifferEntry* e = snifferFindSlot(canId);
+    if(e == NULL || e->canId != canId) return false;
+    out = *e;
+    return true;
+}
+
+// Rate rata-rata sejak frame pertama (Hz)
+float foxSnifferGetRate(const FoxSnifferEntry& entry) {
+    unsigned long span = entry.lastMs - entry.firstMs;
+    if(entry.frames < 2 || span == 0) return 0.0f;
+    return (entry.frames - 1) * 1000.0f / span;
+}
+
+static void printHexBytes(const uint8_t* bytes, uint8_t count) {
+    for(uint8_t i = 0; i < 8; i++) {
+        if(i < count) Serial.printf(" %02X", bytes[i]);
+        else Serial.print(" --");
+    }
+}
+
+// Format per ID:
+//   ID       DLC FRAMES     HZ | LAST                    | TOGGLED
+//            min ... max ...
+void foxSnifferPrintReport() {
+    Serial.printf("=== CAN SNIFFER (%u ID, %lu dropped) ===\n",
+                  snifferCount, (unsigned long)snifferDropped);
+    if(snifferCount == 0) {
+        Serial.println("Belum ada unknown CAN ID (aktifkan CAPTURE ON)");
+        Serial.println("========================");
+        return;
+    }
+
+    // Urutkan index berdasarkan ID supaya report mudah dibandingkan
+    uint8_t order[SNIFFER_TABLE_SIZE];
+    uint8_t n = 0;
+    for(uint8_t i = 0; i < SNIFFER_TABLE_SIZE; i++) {
+        if(snifferTable[i].canId == SNIFFER_EMPTY_ID) continue;
+        uint8_t j = n++;
+        while(j > 0 && snifferTable[order[j - 1]].canId > snifferTable[i].canId) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    Serial.println("ID       DLC FRAMES     HZ | LAST                    | TOGGLED");
+    for(uint8_t k = 0; k < n; k++) {
+        const FoxSnifferEntry& e = snifferTable[order[k]];
+        Serial.printf("%08lX %u %7lu %6.1f |", (unsigned long)e.canId, e.len,
+                      (unsigned long)e.frames, foxSnifferGetRate(e));
+        printHexBytes(e.lastData, e.len);
+        Serial.print(" |");
+        printHexBytes(e.toggled, e.maxLen);
+        Serial.println();
+        Serial.print("         min");
+        printHexBytes(e.minData, e.maxLen);
+        Serial.print("  max");
+        printHexBytes(e.maxData, e.maxLen);
+        Serial.println();
+    }
+    Serial.println("========================");
+}
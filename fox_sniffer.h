@@ -0,0 +1,28 @@
+#ifndef FOX_SNIFFER_H
+#define FOX_SNIFFER_H
+
+#include <Arduino.h>
+
+// Akumulasi per CAN ID yang tidak dikenal (untuk reverse-engineering signal)
+struct FoxSnifferEntry {
+    uint32_t canId;
+    uint32_t frames;
+    unsigned long firstMs;
+    unsigned long lastMs;
+    uint8_t len;                // DLC frame terakhir
+    uint8_t maxLen;             // Byte di atas maxLen belum pernah terlihat
+    uint8_t lastData[8];
+    uint8_t minData[8];
+    uint8_t maxData[8];
+    uint8_t toggled[8];         // Bit yang pernah berubah nilai
+};
+
+void foxSnifferRecord(uint32_t canId, const uint8_t* data, uint8_t len);
+void foxSnifferReset();
+uint8_t foxSnifferGetCount();
+uint32_t foxSnifferGetDropped();
+bool foxSnifferGetEntry(uint32_t canId, FoxSnifferEntry& out);
+float foxSnifferGetRate(const FoxSnifferEntry& entry);
+void foxSnifferPrintReport();
+
+#endif
@@ -0,0 +1,283 @@
+#include "fox_stats.h"
+#include "fox_config.h"
+#include "fox_vehicle.h"
+#include "fox_events.h"
+#include <Arduino.h>
+
+// ========== BUCKET HISTOGRAM ==========
+// Bucket i = [minValue + i * width, minValue + (i+1) * width), ujung di-clamp ke bucket pertama/terakhir
+struct StatsBucketConfig {
+    float minValue;
+    float width;
+};
+
+const StatsBucketConfig statsBuckets[STATS_CHANNEL_COUNT] = {
+    { 0.0f,   10.0f },  // STATS_SPEED: 0..160 km/h
+    { -40.0f, 20.0f },  // STATS_CURRENT: -40..280 A (discharge positif)
+    { 0.0f,   10.0f },  // STATS_TEMP_CONTROLLER: 0..160 C
+    { 0.0f,   10.0f },  // STATS_TEMP_MOTOR: 0..160 C
+};
+
+const float statsQuantileP[STATS_QUANTILE_COUNT] = { 0.50f, 0.95f, 0.99f };
+
+// ========== ESTIMATOR P2 (Jain & Chlamtac) ==========
+// 5 marker per quantile, tanpa menyimpan sample. Posisi ideal marker dihitung
+// dari count, jadi cukup simpan tinggi (q) dan posisi aktual (n).
+struct P2Quantile {
+    float q[5];
+    int32_t n[5];
+};
+
+struct StatsSlot {
+    uint32_t histMs[STATS_BUCKETS];
+    P2Quantile quantile[STATS_QUANTILE_COUNT];
+    uint32_t samples;
+    float min;
+    float max;
+    float weightedSum;          // nilai x ms, untuk mean berbobot waktu
+    uint32_t timeMs;
+    float sampleSum;            // Mean aritmetika selama belum ada waktu terkumpul
+};
+
+// Nilai terakhir per channel, bobot waktu dihitung saat sample berikutnya datang
+struct StatsChannelState {
+    float lastValue;
+    unsigned long lastMs;
+    uint8_t lastMode;
+    bool haveLast;
+};
+
+StatsSlot statsSlots[STATS_MODE_COUNT + 1][STATS_CHANNEL_COUNT];
+StatsChannelState statsState[STATS_CHANNEL_COUNT];
+unsigned long statsSessionStartMs = 0;
+FoxVehicleMode statsMode = MODE_UNKNOWN;   // Mode terakhir dari event bus
+
+// Posisi ideal marker (0-based): (count - 1) x {0, p/2, p, (1+p)/2, 1}
+static float p2Desired(uint8_t marker, float p, uint32_t count) {
+    float dn = (marker == 1) ? p / 2.0f :
+               (marker == 2) ? p :
+               (marker == 3) ? (1.0f + p) / 2.0f : 1.0f;
+    return (count - 1) * dn;
+}
+
+static void p2Add(P2Quantile& est, float p, uint32_t count, float x) {
+    // count = jumlah sample termasuk x
+    if(count <= 5) {
+        // Isi 5 sample pertama secara terurut
+        uint8_t i = count - 1;
+        while(i > 0 && est.q[i - 1] > x) {
+            est.q[i] = est.q[i - 1];
+            i--;
+        }
+        est.q[i] = x;
+        est.n[count - 1] = count - 1;
+        return;
+    }
+
+    uint8_t k;
+    if(x < est.q[0]) {
+        est.q[0] = x;
+        k = 0;
+    } else if(x >= est.q[4]) {
+        est.q[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while(k < 3 && x >= est.q[k + 1]) k++;
+    }
+    for(uint8_t i = k + 1; i < 5; i++) {
+        est.n[i]++;
+    }
+
+    // Geser marker tengah yang menyimpang >= 1 posisi dari ideal
+    for(uint8_t i = 1; i < 4; i++) {
+        float d = p2Desired(i, p, count) - est.n[i];
+        int32_t right = est.n[i + 1] - est.n[i];
+        int32_t left = est.n[i - 1] - est.n[i];
+        if((d >= 1.0f && right > 1) || (d <= -1.0f && left < -1)) {
+            int8_t s = (d > 0) ? 1 : -1;
+            // Parabolic (P2), fallback linear jika keluar urutan
+            float qp = est.q[i] + (float)s / (est.n[i + 1] - est.n[i - 1]) *
+                       ((est.n[i] - est.n[i - 1] + s) * (est.q[i + 1] - est.q[i]) / (est.n[i + 1] - est.n[i]) +
+                        (est.n[i + 1] - est.n[i] - s) * (est.q[i] - est.q[i - 1]) / (est.n[i] - est.n[i - 1]));
+            if(est.q[i - 1] < qp && qp < est.q[i + 1]) {
+                est.q[i] = qp;
+            } else {
+                est.q[i] += s * (est.q[i + s] - est.q[i]) / (est.n[i + s] - est.n[i]);
+            }
+            est.n[i] += s;
+        }
+    }
+}
+
+static float p2Estimate(const P2Quantile& est, float p, uint32_t count) {
+    if(count == 0) return 0.0f;
+    if(count <= 5) {
+        // Sample masih terurut di q[0..count-1] (marker belum pernah digeser):
+        // interpolasi linear antar sample, bukan median q[2]
+        float pos = p * (count - 1);
+        uint8_t idx = (uint8_t)pos;
+        if(idx >= count - 1) return est.q[count - 1];
+        return est.q[idx] + (pos - idx) * (est.q[idx + 1] - est.q[idx]);
+    }
+    return est.q[2];
+}
+
+static uint8_t statsBucket(FoxStatsChannel channel, float value) {
+    const StatsBucketConfig& cfg = statsBuckets[channel];
+    float pos = (value - cfg.minValue) / cfg.width;
+    if(pos <= 0.0f) return 0;
+    if(pos >= STATS_BUCKETS - 1) return STATS_BUCKETS - 1;
+    return (uint8_t)pos;
+}
+
+static void slotAddSample(StatsSlot& slot, float value) {
+    slot.samples++;
+    slot.sampleSum += value;
+    if(slot.samples == 1 || value < slot.min) slot.min = value;
+    if(slot.samples == 1 || value > slot.max) slot.max = value;
+    for(uint8_t q = 0; q < STATS_QUANTILE_COUNT; q++) {
+        p2Add(slot.quantile[q], statsQuantileP[q], slot.samples, value);
+    }
+}
+
+static void slotAddTime(StatsSlot& slot, FoxStatsChannel channel, float value, uint32_t dt) {
+    slot.histMs[statsBucket(channel, value)] += dt;
+    slot.weightedSum += value * dt;
+    slot.timeMs += dt;
+}
+
+// Subscriber event bus: setiap update signal (deadband 0, tanpa rate limit),
+// dengan waktu tiba frame
+static void statsOnEvent(const FoxEvent& event, void* context) {
+    if(event.type == EVENT_MODE_CHANGE) {
+        statsMode = (FoxVehicleMode)event.value;
+        return;
+    }
+    switch(event.signal) {
+        case SIGNAL_SPEED: foxStatsRecord(STATS_SPEED, event.value, statsMode, event.timeMs); break;
+        case SIGNAL_CURRENT: foxStatsRecord(STATS_CURRENT, -event.value, statsMode, event.timeMs); break;
+        case SIGNAL_TEMP_CONTROLLER: foxStatsRecord(STATS_TEMP_CONTROLLER, event.value, statsMode, event.timeMs); break;
+        case SIGNAL_TEMP_MOTOR: foxStatsRecord(STATS_TEMP_MOTOR, event.value, statsMode, event.timeMs); break;
+        default: break;
+    }
+}
+
+// ========== FUNGSI PUBLIK ==========
+void foxStatsInit() {
+    foxEventSubscribe("STATS", statsOnEvent, NULL,
+                      EVENT_MASK(EVENT_MODE_CHANGE) | EVENT_MASK(EVENT_SIGNAL_UPDATE),
+                      EVENT_SIGNAL_MASK(SIGNAL_SPEED) | EVENT_SIGNAL_MASK(SIGNAL_CURRENT) |
+                      EVENT_SIGNAL_MASK(SIGNAL_TEMP_CONTROLLER) | EVENT_SIGNAL_MASK(SIGNAL_TEMP_MOTOR));
+    foxStatsReset();
+}
+
+void foxStatsReset() {
+    memset(statsSlots, 0, sizeof(statsSlots));
+    memset(statsState, 0, sizeof(statsState));
+    statsSessionStartMs = millis();
+}
+
+// Dipanggil dari subscriber event bus (statsOnEvent).
+// O(1): satu bucket histogram + 3 estimator P2 untuk slot mode dan slot gabungan.
+void foxStatsRecord(FoxStatsChannel channel, float value, FoxVehicleMode mode, unsigned long timeMs) {
+    if(channel >= STATS_CHANNEL_COUNT || mode >= STATS_MODE_COUNT) return;
+
+    // Waktu sejak sample sebelumnya milik nilai & mode sebelumnya
+    StatsChannelState& state = statsState[channel];
+    if(state.haveLast) {
+        unsigned long dt = timeMs - state.lastMs;
+        if(dt > 0 && dt <= STATS_MAX_GAP_MS) {
+            slotAddTime(statsSlots[state.lastMode][channel], channel, state.lastValue, dt);
+            slotAddTime(statsSlots[STATS_MODE_ALL][channel], channel, state.lastValue, dt);
+        }
+    }
+    state.lastValue = value;
+    state.lastMs = timeMs;
+    state.lastMode = mode;
+    state.haveLast = true;
+
+    slotAddSample(statsSlots[mode][channel], value);
+    slotAddSample(statsSlots[STATS_MODE_ALL][channel], value);
+}
+
+bool foxStatsGetSummary(FoxStatsChannel channel, uint8_t mode, FoxStatsSummary& out) {
+    if(channel >= STATS_CHANNEL_COUNT || mode > STATS_MODE_ALL) return false;
+    foxVehicleProcess();
+
+    const StatsSlot& slot = statsSlots[mode][channel];
+    out.samples = slot.samples;
+    out.timeMs = slot.timeMs;
+    // Sample pertama belum punya bobot waktu: pakai mean aritmetika
+    if(slot.timeMs > 0) {
+        out.mean = slot.weightedSum / slot.timeMs;
+    } else {
+        out.mean = (slot.samples > 0) ? slot.sampleSum / slot.samples : 0.0f;
+    }
+    out.min = slot.min;
+    out.max = slot.max;
+    for(uint8_t q = 0; q < STATS_QUANTILE_COUNT; q++) {
+        out.quantile[q] = p2Estimate(slot.quantile[q], statsQuantileP[q], slot.samples);
+    }
+    return slot.samples > 0;
+}
+
+// Waktu di bucket dengan batas bawah >= threshold (dibulatkan ke batas bucket)
+unsigned long foxStatsTimeAboveMs(FoxStatsChannel channel, uint8_t mode, float threshold) {
+    if(channel >= STATS_CHANNEL_COUNT || mode > STATS_MODE_ALL) return 0;
+    foxVehicleProcess();
+
+    const StatsBucketConfig& cfg = statsBuckets[channel];
+    const StatsSlot& slot = statsSlots[mode][channel];
+    unsigned long total = 0;
+    for(uint8_t b = 0; b < STATS_BUCKETS; b++) {
+        if(cfg.minValue + b * cfg.width >= threshold) {
+            total += slot.histMs[b];
+        }
+    }
+    return total;
+}
+
+static const char* statsChannelName(uint8_t channel) {
+    switch(channel) {
+        case STATS_SPEED: return "SPEED";
+        case STATS_CURRENT: return "CURRENT";
+        case STATS_TEMP_CONTROLLER: return "TEMP_ECU";
+        case STATS_TEMP_MOTOR: return "TEMP_MOTOR";
+        default: return "UNKNOWN";
+    }
+}
+
+static void statsPrintSlot(uint8_t mode) {
+    FoxStatsSummary sum;
+    bool header = false;
+
+    for(uint8_t ch = 0; ch < STATS_CHANNEL_COUNT; ch++) {
+        if(!foxStatsGetSummary((FoxStatsChannel)ch, mode, sum)) continue;
+        if(!header) {
+            Serial.print("[");
+            Serial.print(mode == STATS_MODE_ALL ? "ALL" : foxVehicleModeToString((FoxVehicleMode)mode));
+            Serial.println("]");
+            header = true;
+        }
+        Serial.printf("  %-10s %5lus mean %6.1f min %6.1f max %6.1f p50 %6.1f p95 %6.1f p99 %6.1f",
+                      statsChannelName(ch), sum.timeMs / 1000, sum.mean, sum.min, sum.max,
+                      sum.quantile[STATS_P50], sum.quantile[STATS_P95], sum.quantile[STATS_P99]);
+        if(ch == STATS_TEMP_CONTROLLER || ch == STATS_TEMP_MOTOR) {
+            Serial.printf(" >=%dC %lus", STATS_TEMP_ALERT_C,
+                          foxStatsTimeAboveMs((FoxStatsChannel)ch, mode, STATS_TEMP_ALERT_C) / 1000);
+        }
+        Serial.println();
+    }
+}
+
+void foxStatsPrint() {
+    unsigned long session = (millis() - statsSessionStartMs) / 1000;
+    Serial.printf("=== STATS (session %02lu:%02lu:%02lu) ===\n",
+                  session / 3600, (session / 60) % 60, session % 60);
+    statsPrintSlot(STATS_MODE_ALL);
+    for(uint8_t mode = 0; mode < STATS_MODE_COUNT; mode++) {
+        statsPrintSlot(mode);
+    }
+    Serial.println("=============");
+}
@@ -0,0 +1,44 @@
+#ifndef FOX_STATS_H
+#define FOX_STATS_H
+
+#include <Arduino.h>
+#include "fox_config.h"
+
+// Channel statistik. CURRENT = arus discharge positif (regen negatif).
+enum FoxStatsChannel {
+    STATS_SPEED = 0,
+    STATS_CURRENT,
+    STATS_TEMP_CONTROLLER,
+    STATS_TEMP_MOTOR,
+    STATS_CHANNEL_COUNT
+};
+
+enum FoxStatsQuantile {
+    STATS_P50 = 0,
+    STATS_P95,
+    STATS_P99,
+    STATS_QUANTILE_COUNT
+};
+
+// Slot per FoxVehicleMode + satu slot gabungan semua mode
+#define STATS_MODE_COUNT (MODE_CHARGING + 1)
+#define STATS_MODE_ALL STATS_MODE_COUNT
+
+// Ringkasan satu channel di satu mode (atau STATS_MODE_ALL)
+struct FoxStatsSummary {
+    uint32_t samples;
+    unsigned long timeMs;       // Total waktu (berbobot waktu antar frame)
+    float mean;                 // Rata-rata berbobot waktu (aritmetika jika timeMs = 0)
+    float min;
+    float max;
+    float quantile[STATS_QUANTILE_COUNT];
+};
+
+void foxStatsInit();
+void foxStatsReset();
+void foxStatsRecord(FoxStatsChannel channel, float value, FoxVehicleMode mode, unsigned long timeMs);
+bool foxStatsGetSummary(FoxStatsChannel channel, uint8_t mode, FoxStatsSummary& out);
+unsigned long foxStatsTimeAboveMs(FoxStatsChannel channel, uint8_t mode, float threshold);
+void foxStatsPrint();
+
+#endif
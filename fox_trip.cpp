@@ -0,0 +1,211 @@
+#include "fox_trip.h"
+#include "fox_config.h"
+#include "fox_vehicle.h"
+#include <Arduino.h>
+
+#ifdef ESP32
+#include <Preferences.h>
+#endif
+
+// ========== AKUMULATOR ==========
+// Disimpan integer supaya increment kecil per frame tidak hilang di total besar:
+//   energi : mJ (W x ms)
+//   jarak  : km/h x ms (1 km = 3.6e6)
+#define TRIP_MJ_PER_WH 3600000.0f
+#define TRIP_UNITS_PER_KM 3600000.0f
+#define TRIP_SEGMENT_UNITS ((uint64_t)TRIP_ROLLING_SEGMENT_M * 3600)
+#define TRIP_NVS_NAMESPACE "foxtrip"
+#define TRIP_NVS_VERSION 1
+
+struct TripTotals {
+    uint32_t version;
+    float rollingWhPerKm;
+    uint64_t energyUsedMJ;
+    uint64_t energyRegenMJ;
+    uint64_t distanceUnits;
+    uint64_t rideMs;
+};
+
+TripTotals tripTotals;
+
+// Nilai frame sebelumnya, dipakai sampai frame berikutnya datang
+float tripLastPower = 0;
+unsigned long tripLastPowerMs = 0;
+bool tripLastCharging = false;
+bool tripHavePower = false;
+uint16_t tripLastSpeed = 0;
+unsigned long tripLastSpeedMs = 0;
+bool tripHaveSpeed = false;
+
+// Awal segment konsumsi rolling
+uint64_t tripSegmentStartUnits = 0;
+int64_t tripSegmentStartNetMJ = 0;
+
+bool tripDirty = false;
+bool tripMovedSinceSave = false;
+unsigned long tripLastSaveMs = 0;
+unsigned long tripLastMovingMs = 0;
+
+#ifdef ESP32
+Preferences tripPrefs;
+#endif
+
+static int64_t tripNetEnergyMJ() {
+    return (int64_t)tripTotals.energyUsedMJ - (int64_t)tripTotals.energyRegenMJ;
+}
+
+static void tripStartSegment() {
+    tripSegmentStartUnits = tripTotals.distanceUnits;
+    tripSegmentStartNetMJ = tripNetEnergyMJ();
+}
+
+static void tripResetTotals() {
+    memset(&tripTotals, 0, sizeof(tripTotals));
+    tripTotals.version = TRIP_NVS_VERSION;
+    tripTotals.rollingWhPerKm = TRIP_DEFAULT_WH_PER_KM;
+    tripStartSegment();
+}
+
+static void tripSave() {
+#ifdef ESP32
+    if(tripPrefs.begin(TRIP_NVS_NAMESPACE, false)) {
+        tripPrefs.putBytes("totals", &tripTotals, sizeof(tripTotals));
+        tripPrefs.end();
+    }
+#endif
+    tripDirty = false;
+    tripMovedSinceSave = false;
+    tripLastSaveMs = millis();
+}
+
+static void tripLoad() {
+    tripResetTotals();
+#ifdef ESP32
+    TripTotals stored;
+    if(tripPrefs.begin(TRIP_NVS_NAMESPACE, true)) {
+        size_t n = tripPrefs.getBytes("totals", &stored, sizeof(stored));
+        tripPrefs.end();
+        if(n == sizeof(stored) && stored.version == TRIP_NVS_VERSION) {
+            tripTotals = stored;
+        }
+    }
+#endif
+    tripStartSegment();
+}
+
+// Fungsi: Perbarui konsumsi rolling setiap TRIP_ROLLING_SEGMENT_M
+static void tripUpdateRolling() {
+    uint64_t segmentUnits = tripTotals.distanceUnits - tripSegmentStartUnits;
+    if(segmentUnits < TRIP_SEGMENT_UNITS) return;
+
+    float segmentKm = segmentUnits / TRIP_UNITS_PER_KM;
+    float segmentWh = (tripNetEnergyMJ() - tripSegmentStartNetMJ) / TRIP_MJ_PER_WH;
+    tripTotals.rollingWhPerKm += TRIP_ROLLING_ALPHA * (segmentWh / segmentKm - tripTotals.rollingWhPerKm);
+    tripStartSegment();
+}
+
+// ========== INTEGRASI PER FRAME ==========
+// Dipanggil dari applyVoltageCurrent() dengan waktu tiba frame.
+// Daya frame sebelumnya dianggap konstan sampai frame ini (tanpa menyimpan sample).
+void foxTripOnPower(float voltage, float current, unsigned long timeMs, bool charging) {
+    if(tripHavePower) {
+        unsigned long dt = timeMs - tripLastPowerMs;
+        if(dt > 0 && dt <= TRIP_MAX_GAP_MS) {
+            // Arus negatif = discharge
+            float energy = tripLastPower * dt;
+            if(energy < 0) {
+                tripTotals.energyUsedMJ += (uint64_t)(-energy + 0.5f);
+                tripDirty = true;
+            } else if(energy > 0 && !tripLastCharging) {
+                tripTotals.energyRegenMJ += (uint64_t)(energy + 0.5f);
+                tripDirty = true;
+            }
+        }
+    }
+    tripLastPower = voltage * current;
+    tripLastPowerMs = timeMs;
+    tripLastCharging = charging;
+    tripHavePower = true;
+}
+
+// Dipanggil dari applySpeed() dengan waktu tiba frame
+void foxTripOnSpeed(uint16_t speedKmh, unsigned long timeMs) {
+    if(tripHaveSpeed && tripLastSpeed > 0) {
+        unsigned long dt = timeMs - tripLastSpeedMs;
+        if(dt > 0 && dt <= TRIP_MAX_GAP_MS) {
+            tripTotals.distanceUnits += (uint64_t)tripLastSpeed * dt;
+            tripTotals.rideMs += dt;
+            tripDirty = true;
+            tripUpdateRolling();
+        }
+    }
+    if(speedKmh > 0) {
+        tripLastMovingMs = timeMs;
+        tripMovedSinceSave = true;
+    }
+    tripLastSpeed = speedKmh;
+    tripLastSpeedMs = timeMs;
+    tripHaveSpeed = true;
+}
+
+// ========== FUNGSI PUBLIK ==========
+void foxTripInit() {
+    tripLoad();
+    tripLastSaveMs = millis();
+    Serial.print("Trip: ");
+    Serial.print(tripTotals.distanceUnits / TRIP_UNITS_PER_KM, 1);
+    Serial.println(" km (restored)");
+}
+
+// Simpan ke NVS hanya saat berubah: berkala, atau begitu motor berhenti
+void foxTripUpdate() {
+    if(!tripDirty) return;
+    unsigned long now = millis();
+    bool stopped = tripMovedSinceSave && (now - tripLastMovingMs > TRIP_SAVE_STOP_MS);
+    if(stopped || now - tripLastSaveMs > TRIP_SAVE_INTERVAL_MS) {
+        tripSave();
+    }
+}
+
+void foxTripReset() {
+    tripResetTotals();
+    tripSave();
+}
+
+FoxTripData foxTripGetData() {
+    // Decode pending dulu supaya total ikut frame terbaru
+    const FoxVehicleData& vehicle = foxVehicleGetDataRef();
+
+    FoxTripData trip;
+    trip.distanceKm = tripTotals.distanceUnits / TRIP_UNITS_PER_KM;
+    trip.whUsed = tripTotals.energyUsedMJ / TRIP_MJ_PER_WH;
+    trip.whRegen = tripTotals.energyRegenMJ / TRIP_MJ_PER_WH;
+    trip.whPerKm = (trip.distanceKm >= 0.1f) ? (trip.whUsed - trip.whRegen) / trip.distanceKm : 0.0f;
+    trip.rollingWhPerKm = tripTotals.rollingWhPerKm;
+    trip.rideTimeS = (unsigned long)(tripTotals.rideMs / 1000);
+
+    if(foxSignalValid(vehicle, SIGNAL_SOC)) {
+        // Turunan/regen panjang bisa membuat rolling <= 0, batasi supaya range tetap masuk akal
+        float rate = (trip.rollingWhPerKm < 1.0f) ? 1.0f : trip.rollingWhPerKm;
+        trip.rangeKm = vehicle.soc * (TRIP_PACK_CAPACITY_WH / 100.0f) / rate;
+    } else {
+        trip.rangeKm = -1.0f;
+    }
+    return trip;
+}
+
+void foxTripPrint() {
+    FoxTripData trip = foxTripGetData();
+    Serial.println("=== TRIP ===");
+    Serial.printf("Distance: %.2f km\n", trip.distanceKm);
+    Serial.printf("Ride time: %02lu:%02lu:%02lu\n",
+                  trip.rideTimeS / 3600, (trip.rideTimeS / 60) % 60, trip.rideTimeS % 60);
+    Serial.printf("Energy: %.1f Wh used, %.1f Wh regen\n", trip.whUsed, trip.whRegen);
+    Serial.printf("Consumption: %.1f Wh/km (rolling %.1f)\n", trip.whPerKm, trip.rollingWhPerKm);
+    if(trip.rangeKm >= 0) {
+        Serial.printf("Range: %.0f km\n", trip.rangeKm);
+    } else {
+        Serial.println("Range: -- (SOC belum valid)");
+    }
+    Serial.println("============");
+}
@@ -0,0 +1,25 @@
+#ifndef FOX_TRIP_H
+#define FOX_TRIP_H
+
+#include <Arduino.h>
+
+// Ringkasan trip (nilai turunan dihitung saat dibaca)
+struct FoxTripData {
+    float distanceKm;
+    float whUsed;               // Energi keluar dari baterai
+    float whRegen;              // Energi masuk dari regen (tidak termasuk charging)
+    float whPerKm;              // (used - regen) / jarak trip, 0 jika jarak < 0.1 km
+    float rollingWhPerKm;       // Konsumsi ~1 km terakhir (EWMA per segment)
+    float rangeKm;              // Estimasi sisa jarak, < 0 jika SOC belum valid
+    unsigned long rideTimeS;    // Waktu bergerak (speed > 0)
+};
+
+void foxTripInit();
+void foxTripUpdate();
+void foxTripOnPower(float voltage, float current, unsigned long timeMs, bool charging);
+void foxTripOnSpeed(uint16_t speedKmh, unsigned long timeMs);
+void foxTripReset();
+FoxTripData foxTripGetData();
+void foxTripPrint();
+
+#endif
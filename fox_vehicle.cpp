@@ -1,6 +1,17 @@
 #include "fox_vehicle.h"
 #include "fox_config.h"
+#include "fox_candb.h"
+#include "fox_canlog.h"
+#include "fox_sniffer.h"
+#include "fox_trip.h"
+#include "fox_events.h"
+#include "fox_rtc.h"
 #include <Arduino.h>
+#include <atomic>
+
+#ifdef ESP32
+#include <Preferences.h>
+#endif
 
 // Lookup table SOC to BMS value (0-100%) - untuk referensi
 const uint16_t socToBms[101] = {
@@ -25,80 +36,277 @@ FoxVehicleData vehicleData = {
     .current = 0.0,
     .soc = 0,
     .lastUpdate = 0,
-    .rpmValid = false,
-    .speedValid = false,
-    .tempValid = false,
-    .voltageValid = false,
-    .socValid = false
+    .validMask = 0,
+    .signalTime = {0}
+};
+
+// Timeout per signal (urutan sama dengan FoxVehicleSignal)
+const uint16_t signalTimeoutMs[SIGNAL_COUNT] = {
+    SIGNAL_TIMEOUT_MODE_MS,         // SIGNAL_MODE
+    SIGNAL_TIMEOUT_MODE_MS,         // SIGNAL_RPM
+    SIGNAL_TIMEOUT_SPEED_MS,        // SIGNAL_SPEED
+    SIGNAL_TIMEOUT_TEMP_MS,         // SIGNAL_TEMP_CONTROLLER
+    SIGNAL_TIMEOUT_TEMP_MS,         // SIGNAL_TEMP_MOTOR
+    SIGNAL_TIMEOUT_TEMP_MS,         // SIGNAL_TEMP_BATTERY
+    SIGNAL_TIMEOUT_ELECTRICAL_MS,   // SIGNAL_VOLTAGE
+    SIGNAL_TIMEOUT_ELECTRICAL_MS,   // SIGNAL_CURRENT
+    SIGNAL_TIMEOUT_SOC_MS           // SIGNAL_SOC
 };
 
+// Signal yang pernah diterima sejak boot (validMask bisa dihapus oleh timeout)
+uint16_t signalSeenMask = 0;
+
+// Waktu tiba frame yang sedang di-apply, diisi processMailboxes()
+unsigned long signalArrivalMs = 0;
+
+// Salinan yang dibaca UI/task lain. Ditulis hanya oleh publishVehicleData() (seqlock):
+// vehicleSeq ganjil = sedang ditulis, vehicleSeq / 2 = generation.
+FoxVehicleData vehicleSnapshot;
+std::atomic<uint32_t> vehicleSeq(0);
+
+// Baseline event bus, lihat publishEvents()
+FoxVehicleData eventBaseline;
+uint32_t eventSeq = 0;
+bool eventDispatching = false;
+
 bool captureUnknownCAN = false;
 
-// ========== [ENHANCED] UNKNOWN MODE PROTECTION ==========
-#define MAX_UNKNOWN_BYTES 30
-uint8_t unknownBytesSeen[MAX_UNKNOWN_BYTES];
-uint8_t unknownBytesCount = 0;
-FoxVehicleMode unknownModeFallback = MODE_PARK;  // Safe fallback mode
+// Nilai fisik terakhir tiap signal dari FOX_CAN_SIGNALS
+float canSignals[CANSIG_COUNT];
+
+// ========== KLASIFIKASI MODE BYTE ==========
+// Tabel 256 entry dibangun saat compile: byte mode -> FoxVehicleMode dalam satu load.
+// Byte yang tidak dikenal diberi flag MODE_CLASS_UNKNOWN dengan safe fallback sebagai mode.
+#define MODE_CLASS_UNKNOWN 0x80
+#define MODE_CLASS_MODE_MASK 0x7F
+
+struct ModeByteTable {
+    uint8_t entry[256];
+};
+
+// Fungsi: Tentukan safe fallback mode berdasarkan pola byte
+constexpr FoxVehicleMode determineSafeFallback(uint8_t modeByte) {
+    if((modeByte & 0x0F) == 0x01) return MODE_CHARGING;    // Pattern berakhiran 1 = charging
+    if(modeByte == 0x00) return MODE_PARK;
+    if((modeByte & 0xF0) == 0x70) return MODE_DRIVE;       // Pattern 0x7X = drive
+    if((modeByte & 0xF0) == 0xB0) return MODE_SPORT;       // Pattern 0xBX = sport
+    return MODE_PARK;                                      // Default safe fallback
+}
+
+constexpr ModeByteTable buildModeByteTable() {
+    ModeByteTable table = {};
+    for(int b = 0; b < 256; b++) {
+        table.entry[b] = MODE_CLASS_UNKNOWN | determineSafeFallback((uint8_t)b);
+    }
+    table.entry[MODE_BYTE_PARK] = MODE_PARK;
+    table.entry[MODE_BYTE_DRIVE] = MODE_DRIVE;
+    table.entry[MODE_BYTE_SPORT] = MODE_SPORT;
+    table.entry[MODE_BYTE_CRUISE] = MODE_CRUISE;
+    table.entry[MODE_BYTE_SPORT_CRUISE] = MODE_SPORT_CRUISE;
+    table.entry[MODE_BYTE_CUTOFF_1] = MODE_CUTOFF;
+    table.entry[MODE_BYTE_CUTOFF_2] = MODE_CUTOFF;
+    table.entry[MODE_BYTE_STANDBY_1] = MODE_STANDBY;
+    table.entry[MODE_BYTE_STANDBY_2] = MODE_STANDBY;
+    table.entry[MODE_BYTE_STANDBY_3] = MODE_STANDBY;
+    table.entry[MODE_BYTE_REVERSE] = MODE_REVERSE;
+    table.entry[MODE_BYTE_NEUTRAL] = MODE_NEUTRAL;
+    table.entry[MODE_BYTE_CHARGING_1] = MODE_CHARGING;
+    table.entry[MODE_BYTE_CHARGING_2] = MODE_CHARGING;
+    table.entry[MODE_BYTE_CHARGING_3] = MODE_CHARGING;
+    table.entry[MODE_BYTE_CHARGING_4] = MODE_CHARGING;
+    return table;
+}
+
+constexpr ModeByteTable modeByteTable = buildModeByteTable();
+
+static_assert(MODE_CHARGING <= MODE_CLASS_MODE_MASK, "FoxVehicleMode tidak muat di entry tabel");
+static_assert(modeByteTable.entry[MODE_BYTE_CHARGING_4] == MODE_CHARGING, "Tabel mode byte salah");
+static_assert(modeByteTable.entry[0x7F] == (MODE_CLASS_UNKNOWN | MODE_DRIVE), "Fallback 0x7X harus DRIVE");
+
+// ========== UNKNOWN MODE BYTE (dipelajari, disimpan ke NVS) ==========
+#define UNKNOWN_MODE_NVS_NAMESPACE "foxmode"
+#define UNKNOWN_MODE_NVS_VERSION 1
+
+struct UnknownModeRecord {
+    uint8_t modeByte;
+    uint32_t count;
+    RTCDateTime firstSeen;      // year 0 = waktu RTC tidak tersedia
+};
+
+struct UnknownModeStore {
+    uint32_t version;
+    uint8_t count;
+    UnknownModeRecord records[UNKNOWN_MODE_MAX_RECORDS];
+};
+
+UnknownModeStore unknownModes;
+uint32_t unknownModeSeenBits[256 / 32];     // Bitmap byte yang sudah pernah dilihat
+uint8_t unknownModeSlot[256];               // Index record + 1, 0 = tidak punya record
+uint32_t unknownModeDropped = 0;            // Byte baru saat record penuh
+bool unknownModeDirty = false;
+bool unknownModeNew = false;
+unsigned long unknownModeLastSaveMs = 0;
+
+#ifdef ESP32
+Preferences unknownModePrefs;
+#endif
 
 // Function prototypes untuk internal functions
-void parseSOC(const uint8_t* data, uint8_t len);
+void linkMessageHandlers();
 void logUnknownMode(uint8_t modeByte);
 void logModeChange(uint8_t modeByte);
-bool isByteAlreadySeen(uint8_t byte);
-void addByteToSeenList(uint8_t byte);
-FoxVehicleMode determineSafeFallback(uint8_t modeByte);
+void noteUnknownModeByte(uint8_t modeByte);
+void loadUnknownModes();
+void publishVehicleData();
+void publishEvents(unsigned long now);
+void markSignal(FoxVehicleSignal signal);
+bool expireSignals(unsigned long now);
 
 void foxVehicleInit() {
     Serial.println("Vehicle module initialized");
     vehicleData.lastUpdate = millis();
     
-    // Initialize unknown bytes tracking
-    memset(unknownBytesSeen, 0, sizeof(unknownBytesSeen));
-    unknownBytesCount = 0;
+    // Unknown mode byte yang sudah dipelajari (NVS)
+    loadUnknownModes();
+    
+    linkMessageHandlers();
+    publishVehicleData();
+    
+    // Subscriber hanya menerima perubahan setelah init
+    eventBaseline = vehicleData;
+    eventSeq = vehicleSeq.load(std::memory_order_relaxed);
+}
+
+// Fungsi: Salin vehicleData (milik writer) ke snapshot dengan seqlock
+void publishVehicleData() {
+    uint32_t seq = vehicleSeq.load(std::memory_order_relaxed);
+    vehicleSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    vehicleSnapshot = vehicleData;
+    vehicleSeq.store(seq + 2, std::memory_order_release);
 }
 
-// Fungsi: Cek apakah byte sudah pernah dilihat
-bool isByteAlreadySeen(uint8_t byte) {
-    for(int i = 0; i < unknownBytesCount; i++) {
-        if(unknownBytesSeen[i] == byte) {
-            return true;
+// ========== EVENT BUS ==========
+// Event dihitung dari selisih vehicleData dengan baseline (nilai yang terakhir sudah
+// dikirim ke subscriber), sekali per batch. Handler boleh membaca data lagi; decode
+// bersarang tidak mengirim event, perubahannya menyusul di panggilan berikutnya.
+void publishEvents(unsigned long now) {
+    if(eventDispatching) return;
+    eventDispatching = true;
+    
+    uint32_t seq = vehicleSeq.load(std::memory_order_relaxed);
+    if(seq != eventSeq) {
+        eventSeq = seq;
+        FoxVehicleData current = vehicleData;
+        
+        // Mode dulu, supaya subscriber signal sudah tahu mode batch ini
+        if(current.mode != eventBaseline.mode) {
+            foxEventPublishMode(current.mode, eventBaseline.mode, current.signalTime[SIGNAL_MODE]);
         }
+        
+        for(uint8_t s = 0; s < SIGNAL_COUNT; s++) {
+            FoxVehicleSignal signal = (FoxVehicleSignal)s;
+            bool valid = foxSignalValid(current, signal);
+            if(valid != foxSignalValid(eventBaseline, signal)) {
+                foxEventPublishValidity(signal, valid, valid ? current.signalTime[s] : now);
+            }
+            if(valid && current.signalTime[s] != eventBaseline.signalTime[s]) {
+                foxEventPublishSignal(signal, foxVehicleSignalValue(current, signal), current.signalTime[s]);
+            }
+        }
+        eventBaseline = current;
     }
-    return false;
+    
+    // Update yang tertahan rate limit subscriber
+    foxEventFlush(now);
+    eventDispatching = false;
 }
 
-// Fungsi: Tambah byte ke list yang sudah dilihat
-void addByteToSeenList(uint8_t byte) {
-    if(unknownBytesCount >= MAX_UNKNOWN_BYTES) {
-        // List penuh, geser semua elemen ke kiri
-        for(int i = 0; i < MAX_UNKNOWN_BYTES - 1; i++) {
-            unknownBytesSeen[i] = unknownBytesSeen[i + 1];
-        }
-        unknownBytesSeen[MAX_UNKNOWN_BYTES - 1] = byte;
-    } else {
-        unknownBytesSeen[unknownBytesCount] = byte;
-        unknownBytesCount++;
+// Fungsi: Bangun ulang bitmap & index dari record
+static void rebuildUnknownModeIndex() {
+    memset(unknownModeSeenBits, 0, sizeof(unknownModeSeenBits));
+    memset(unknownModeSlot, 0, sizeof(unknownModeSlot));
+    for(uint8_t i = 0; i < unknownModes.count; i++) {
+        uint8_t b = unknownModes.records[i].modeByte;
+        unknownModeSeenBits[b >> 5] |= 1UL << (b & 31);
+        unknownModeSlot[b] = i + 1;
     }
 }
 
-// Fungsi: Tentukan safe fallback mode berdasarkan byte
-FoxVehicleMode determineSafeFallback(uint8_t modeByte) {
-    // Analisis byte untuk pattern yang aman
-    if ((modeByte & 0x0F) == 0x01) {
-        return MODE_CHARGING;  // Pattern berakhiran 1 = charging
+static void resetUnknownModes() {
+    memset(&unknownModes, 0, sizeof(unknownModes));
+    unknownModes.version = UNKNOWN_MODE_NVS_VERSION;
+    unknownModeDropped = 0;
+    rebuildUnknownModeIndex();
+}
+
+static void saveUnknownModes() {
+#ifdef ESP32
+    if(unknownModePrefs.begin(UNKNOWN_MODE_NVS_NAMESPACE, false)) {
+        unknownModePrefs.putBytes("records", &unknownModes, sizeof(unknownModes));
+        unknownModePrefs.end();
     }
-    else if (modeByte == 0x00) {
-        return MODE_PARK;
+#endif
+    unknownModeDirty = false;
+    unknownModeNew = false;
+    unknownModeLastSaveMs = millis();
+}
+
+void loadUnknownModes() {
+    resetUnknownModes();
+#ifdef ESP32
+    UnknownModeStore stored;
+    if(unknownModePrefs.begin(UNKNOWN_MODE_NVS_NAMESPACE, true)) {
+        size_t n = unknownModePrefs.getBytes("records", &stored, sizeof(stored));
+        unknownModePrefs.end();
+        if(n == sizeof(stored) && stored.version == UNKNOWN_MODE_NVS_VERSION &&
+           stored.count <= UNKNOWN_MODE_MAX_RECORDS) {
+            unknownModes = stored;
+        }
     }
-    else if ((modeByte & 0xF0) == 0x70) {
-        return MODE_DRIVE;  // Pattern 0x7X = drive
+#endif
+    rebuildUnknownModeIndex();
+    unknownModeDirty = false;
+    unknownModeNew = false;
+    unknownModeLastSaveMs = millis();
+    if(unknownModes.count > 0) {
+        Serial.print("Unknown mode bytes: ");
+        Serial.print(unknownModes.count);
+        Serial.println(" learned (restored)");
     }
-    else if ((modeByte & 0xF0) == 0xB0) {
-        return MODE_SPORT;  // Pattern 0xBX = sport
+}
+
+// Fungsi: Catat byte mode unknown. Byte yang sudah terlihat cukup satu cek bitmap + increment.
+void noteUnknownModeByte(uint8_t modeByte) {
+    uint32_t bit = 1UL << (modeByte & 31);
+    uint32_t& word = unknownModeSeenBits[modeByte >> 5];
+    if(word & bit) {
+        uint8_t slot = unknownModeSlot[modeByte];
+        if(slot) {
+            unknownModes.records[slot - 1].count++;
+            unknownModeDirty = true;
+        }
+        return;
     }
-    
-    // Default safe fallback
-    return MODE_PARK;
+
+    // Pertama kali terlihat
+    word |= bit;
+    logUnknownMode(modeByte);
+    if(unknownModes.count >= UNKNOWN_MODE_MAX_RECORDS) {
+        unknownModeDropped++;
+        return;
+    }
+    UnknownModeRecord& rec = unknownModes.records[unknownModes.count++];
+    rec.modeByte = modeByte;
+    rec.count = 1;
+#ifdef ESP32
+    rec.firstSeen = foxRTCGetDateTime();
+#else
+    memset(&rec.firstSeen, 0, sizeof(rec.firstSeen));  // Host build tanpa RTC
+#endif
+    unknownModeSlot[modeByte] = unknownModes.count;
+    unknownModeDirty = true;
+    unknownModeNew = true;
 }
 
 // Fungsi: Convert BMS raw value to SOC percentage
@@ -120,22 +328,21 @@ uint16_t socToBMS(uint8_t socPercent) {
     return 50 + socPercent * 9;
 }
 
-// Fungsi parseSOC
-void parseSOC(const uint8_t* data, uint8_t len) {
-    if(len < 2) return;
-    
-    uint16_t bmsValue = (data[0] << 8) | data[1];
+// Fungsi applySOC
+void applySOC() {
+    uint16_t bmsValue = (uint16_t)canSignals[CANSIG_SOC_RAW];
     static uint16_t lastBmsValue = 0;
     static uint8_t lastSOC = 0;
     
+    // Timestamp tetap diperbarui walau nilai SOC sama
+    markSignal(SIGNAL_SOC);
+    
     if(bmsValue != lastBmsValue) {
         vehicleData.soc = bmsToSOC(bmsValue);
-        vehicleData.socValid = true;
         lastSOC = vehicleData.soc;
         lastBmsValue = bmsValue;
         
-        FoxVehicleData currentData = foxVehicleGetData();
-        if(currentData.mode != MODE_CHARGING || lastSOC % 10 == 0) {
+        if(vehicleData.mode != MODE_CHARGING || lastSOC % 10 == 0) {
             Serial.print("SOC: ");
             Serial.print(vehicleData.soc);
             Serial.println("%");
@@ -143,171 +350,192 @@ void parseSOC(const uint8_t* data, uint8_t len) {
     }
 }
 
-// FUNGSI UTAMA DENGAN PROTECTION
-void foxVehicleUpdateFromCAN(uint32_t canId, const uint8_t* data, uint8_t len) {
-    // ========== FILTER CHARGER MESSAGES ==========
-    if(canId == FOX_CAN_CHARGER_1 || canId == FOX_CAN_CHARGER_2) {
-        return;
+// ========== FRESHNESS PER SIGNAL ==========
+void markSignal(FoxVehicleSignal signal) {
+    vehicleData.signalTime[signal] = signalArrivalMs;
+    vehicleData.validMask |= (1u << signal);
+    signalSeenMask |= (1u << signal);
+}
+
+// Fungsi: Hapus valid bit signal yang melewati timeout, log sekali per gap
+bool expireSignals(unsigned long now) {
+    bool expired = false;
+    for(uint8_t s = 0; s < SIGNAL_COUNT; s++) {
+        if(!(vehicleData.validMask & (1u << s))) continue;
+        if(now - vehicleData.signalTime[s] <= signalTimeoutMs[s]) continue;
+        
+        vehicleData.validMask &= ~(1u << s);
+        expired = true;
+        
+        Serial.print("[STALE] ");
+        Serial.print(foxVehicleSignalName((FoxVehicleSignal)s));
+        Serial.print(": no frame for ");
+        Serial.print(now - vehicleData.signalTime[s]);
+        Serial.println(" ms");
+    }
+    return expired;
+}
+
+// ========== PER-ID MAILBOX ==========
+// Setiap message di FOX_CAN_MESSAGES punya mailbox yang selalu menyimpan
+// payload terbaru. Decode dilakukan lazy saat data dibaca, dengan interval
+// per ID, sehingga frame jarang (SOC, suhu baterai) tidak pernah kalah oleh
+// frame mode/RPM yang datang jauh lebih sering.
+struct CANMailbox {
+    uint8_t data[8];
+    uint8_t len;
+    bool pending;
+    unsigned long lastArrival;
+    unsigned long lastDecode;
+    uint32_t superseded;    // Frame yang tertimpa sebelum sempat di-decode
+};
+
+CANMailbox canMailboxes[FOX_CAN_MESSAGE_COUNT];
+
+// Logika kendaraan setelah signal message di-decode
+struct CANMessageHandler {
+    uint32_t canId;
+    void (*apply)();
+};
+
+const CANMessageHandler canMessageHandlers[] = {
+    { FOX_CAN_MODE_STATUS,     applyModeStatus },
+    { FOX_CAN_TEMP_CTRL_MOT,   applySpeed },
+    { FOX_CAN_TEMP_BATT_5S,    applyBatteryTemp5S },
+    { FOX_CAN_TEMP_BATT_SGL,   applyBatteryTempSingle },
+    { FOX_CAN_VOLTAGE_CURRENT, applyVoltageCurrent },
+    { FOX_CAN_SOC,             applySOC },
+};
+
+// Handler per index message, dihubungkan sekali di foxVehicleInit()
+void (*canMessageApply[FOX_CAN_MESSAGE_COUNT])() = {};
+
+void linkMessageHandlers() {
+    for(uint8_t i = 0; i < sizeof(canMessageHandlers) / sizeof(canMessageHandlers[0]); i++) {
+        int8_t m = foxCANFindMessage(canMessageHandlers[i].canId);
+        if(m >= 0) {
+            canMessageApply[m] = canMessageHandlers[i].apply;
+        }
     }
+}
+
+// Fungsi: Decode mailbox yang punya payload baru dan intervalnya sudah lewat
+void processMailboxes() {
+    unsigned long now = millis();
+    bool charging = (vehicleData.mode == MODE_CHARGING);
+    bool applied = false;
     
-    // ========== IGNORE BMS INFO MESSAGE ==========
-    if(canId == FOX_CAN_BMS_INFO) {
-        return;
+    for(uint8_t m = 0; m < FOX_CAN_MESSAGE_COUNT; m++) {
+        CANMailbox& mb = canMailboxes[m];
+        if(!mb.pending) continue;
+        
+        unsigned long interval = FOX_CAN_MESSAGES[m].decodeIntervalMs;
+        if(charging && interval < CAN_DECODE_INTERVAL_CHARGING_MS) {
+            interval = CAN_DECODE_INTERVAL_CHARGING_MS;
+        }
+        
+        if(mb.lastDecode != 0 && now - mb.lastDecode < interval) {
+            continue;
+        }
+        
+        mb.pending = false;
+        mb.lastDecode = now;
+        signalArrivalMs = mb.lastArrival;
+        FOX_CAN_DECODERS[m](mb.data, canSignals);
+        if(canMessageApply[m] != NULL) {
+            canMessageApply[m]();
+        }
+        applied = true;
     }
     
-    // ========== WHITELIST HANYA MESSAGE YANG DIKENAL ==========
-    bool knownMessage = false;
+    if(expireSignals(now)) {
+        applied = true;
+    }
     
-    switch(canId) {
-        case FOX_CAN_MODE_STATUS:
-        case FOX_CAN_TEMP_CTRL_MOT:
-        case FOX_CAN_TEMP_BATT_5S:
-        case FOX_CAN_TEMP_BATT_SGL:
-        case FOX_CAN_VOLTAGE_CURRENT:
-        case FOX_CAN_SOC:
-            knownMessage = true;
-            break;
-        default:
-            knownMessage = false;
-            break;
+    // Publish sekali per batch, bukan per field
+    if(applied) {
+        publishVehicleData();
     }
+    publishEvents(now);
+}
+
+// Fungsi: Petakan timestamp RX (micros() di task RX) ke domain millis().
+// Waktu tiba tidak ikut jitter / stall loop yang menguras ring buffer.
+static unsigned long frameArrivalMs(uint32_t timestampUs) {
+    return millis() - (uint32_t)(micros() - timestampUs) / 1000;
+}
+
+// FUNGSI UTAMA: simpan frame ke mailbox, decode dilakukan saat data dibaca
+void foxVehicleUpdateFromCAN(uint32_t canId, const uint8_t* data, uint8_t len, uint32_t timestampUs) {
+    // Recorder hanya menyalin ke buffer RAM, penulisan flash di task terpisah
+    foxCANLogRecord(canId, data, len, timestampUs);
+    
+    // Charger, BMS info dan ID lain sudah dibuang oleh filter hardware TWAI.
+    // Whitelist di bawah tetap dipakai saat CAPTURE ON (filter accept all).
+    int8_t m = foxCANFindMessage(canId);
     
-    if(!knownMessage) {
+    if(m < 0) {
         if(captureUnknownCAN) {
             captureUnknownCANData(canId, data, len);
         }
         return;
     }
     
-    // ========== THROTTLE CAN PROCESSING ==========
-    static unsigned long lastCANProcess = 0;
-    unsigned long now = millis();
-    
-    FoxVehicleData currentData = foxVehicleGetData();
-    unsigned long minInterval = (currentData.mode == MODE_CHARGING) ? 100 : 10;
-    
-    if(now - lastCANProcess < minInterval) {
+    if(len < FOX_CAN_MESSAGES[m].dlc) {
         return;
     }
+    if(len > 8) len = 8;
     
-    lastCANProcess = now;
-    vehicleData.lastUpdate = now;
-    
-    // ========== PROSES MESSAGE YANG DIKENAL ==========
-    if(canId == FOX_CAN_MODE_STATUS && len >= 8) {
-        parseModeStatus(data, len);
-    }
-    else if(canId == FOX_CAN_TEMP_CTRL_MOT && len >= 6) {
-        parseSpeedAndTemp(data, len);
-    }
-    else if(canId == FOX_CAN_TEMP_BATT_5S && len >= 5) {
-        parseBatteryTemp5S(data, len);
-    }
-    else if(canId == FOX_CAN_TEMP_BATT_SGL && len >= 6) {
-        parseBatteryTempSingle(data, len);
-    }
-    else if(canId == FOX_CAN_VOLTAGE_CURRENT && len >= 4) {
-        parseVoltageCurrent(data, len);
-    }
-    else if(canId == FOX_CAN_SOC && len >= 2) {
-        parseSOC(data, len);
+    CANMailbox& mb = canMailboxes[m];
+    if(mb.pending) {
+        mb.superseded++;
     }
+    
+    memcpy(mb.data, data, len);
+    mb.len = len;
+    mb.pending = true;
+    mb.lastArrival = frameArrivalMs(timestampUs);
+    vehicleData.lastUpdate = mb.lastArrival;
 }
 
-// PARSING VOLTAGE DAN CURRENT
-void parseVoltageCurrent(const uint8_t* data, uint8_t len) {
-    if(len >= 4) {
-        // VOLTAGE
-        uint16_t voltageRaw = (data[0] << 8) | data[1];
-        float newVoltage = voltageRaw * 0.1f;
-        
-        // CURRENT
-        uint16_t rawCurrent = (data[2] << 8) | data[3];
-        bool isDischarge = (rawCurrent & 0x8000) != 0;
-        float newCurrent;
-        
-        if (isDischarge) {
-            uint16_t complement = (0x10000 - rawCurrent);
-            newCurrent = -(complement * 0.1f);
-        } else {
-            newCurrent = rawCurrent * 0.1f;
-        }
-        
-        if (fabs(newCurrent) < BMS_DEADZONE_CURRENT) {
-            newCurrent = 0.0f;
-        }
-        
-        vehicleData.voltage = newVoltage;
-        vehicleData.current = newCurrent;
-        vehicleData.voltageValid = true;
-        
-        FoxVehicleData currentData = foxVehicleGetData();
-        if(currentData.mode != MODE_CHARGING) {
-            static unsigned long lastLog = 0;
-            if(millis() - lastLog > 5000) {
-                Serial.print("BMS: V=");
-                Serial.print(newVoltage, 1);
-                Serial.print("V, I=");
-                Serial.print(newCurrent, 1);
-                Serial.println("A");
-                lastLog = millis();
-            }
-        }
+// VOLTAGE DAN CURRENT (arus negatif = discharge)
+void applyVoltageCurrent() {
+    float newVoltage = canSignals[CANSIG_VOLTAGE];
+    float newCurrent = canSignals[CANSIG_CURRENT];
+    
+    if (fabs(newCurrent) < BMS_DEADZONE_CURRENT) {
+        newCurrent = 0.0f;
     }
+    
+    vehicleData.voltage = newVoltage;
+    vehicleData.current = newCurrent;
+    markSignal(SIGNAL_VOLTAGE);
+    markSignal(SIGNAL_CURRENT);
+    
+    // Integrasi energi trip pakai waktu tiba frame
+    foxTripOnPower(newVoltage, newCurrent, signalArrivalMs, vehicleData.mode == MODE_CHARGING);
 }
 
-// PARSING MODE STATUS DENGAN PROTECTION
-void parseModeStatus(const uint8_t* data, uint8_t len) {
-    uint8_t modeByte = data[1];
+// MODE STATUS DENGAN PROTECTION
+void applyModeStatus() {
+    uint8_t modeByte = (uint8_t)canSignals[CANSIG_MODE_BYTE];
     
-    // DETEKSI CHARGING
-    if (IS_CHARGING_MODE(modeByte)) {
-        vehicleData.mode = MODE_CHARGING;
-    }
-    else {
-        switch(modeByte) {
-            case MODE_BYTE_PARK: vehicleData.mode = MODE_PARK; break;
-            case MODE_BYTE_DRIVE: vehicleData.mode = MODE_DRIVE; break;
-            case MODE_BYTE_SPORT: vehicleData.mode = MODE_SPORT; break;
-            case MODE_BYTE_CRUISE: vehicleData.mode = MODE_CRUISE; break;
-            case MODE_BYTE_SPORT_CRUISE: vehicleData.mode = MODE_SPORT_CRUISE; break;
-            case MODE_BYTE_CUTOFF_1: 
-            case MODE_BYTE_CUTOFF_2: vehicleData.mode = MODE_CUTOFF; break;
-            case MODE_BYTE_STANDBY_1: 
-            case MODE_BYTE_STANDBY_2: 
-            case MODE_BYTE_STANDBY_3: vehicleData.mode = MODE_STANDBY; break;
-            case MODE_BYTE_REVERSE: vehicleData.mode = MODE_REVERSE; break;
-            case MODE_BYTE_NEUTRAL: vehicleData.mode = MODE_NEUTRAL; break;
-            default: 
-                // ========== [ENHANCED] UNKNOWN MODE HANDLING ==========
-                if (IS_KNOWN_MODE(modeByte)) {
-                    // Mode known berdasarkan macro, tapi belum ada di switch
-                    // Gunakan safe fallback
-                    vehicleData.mode = determineSafeFallback(modeByte);
-                    logUnknownMode(modeByte);
-                } else {
-                    // Mode benar-benar unknown
-                    if (!isByteAlreadySeen(modeByte)) {
-                        // Log pertama kali
-                        logUnknownMode(modeByte);
-                        addByteToSeenList(modeByte);
-                        
-                        // Set safe fallback untuk mencegah display crash
-                        unknownModeFallback = determineSafeFallback(modeByte);
-                    }
-                    // Gunakan safe fallback untuk semua unknown modes
-                    vehicleData.mode = unknownModeFallback;
-                }
-                break;
-        }
+    // Satu lookup tabel; byte unknown memakai safe fallback per byte
+    uint8_t modeClass = modeByteTable.entry[modeByte];
+    vehicleData.mode = (FoxVehicleMode)(modeClass & MODE_CLASS_MODE_MASK);
+    if(modeClass & MODE_CLASS_UNKNOWN) {
+        noteUnknownModeByte(modeByte);
     }
     
-    vehicleData.rpm = data[2] | (data[3] << 8);
-    vehicleData.rpmValid = true;
+    markSignal(SIGNAL_MODE);
     
-    vehicleData.tempController = data[4];
-    vehicleData.tempMotor = data[5];
-    vehicleData.tempValid = true;
+    vehicleData.rpm = (uint16_t)canSignals[CANSIG_RPM];
+    markSignal(SIGNAL_RPM);
+    
+    vehicleData.tempController = (uint8_t)canSignals[CANSIG_TEMP_CTRL];
+    vehicleData.tempMotor = (uint8_t)canSignals[CANSIG_TEMP_MOTOR];
+    markSignal(SIGNAL_TEMP_CONTROLLER);
+    markSignal(SIGNAL_TEMP_MOTOR);
     
     vehicleData.sportActive = (vehicleData.mode == MODE_SPORT || 
                                vehicleData.mode == MODE_SPORT_CRUISE);
@@ -315,64 +543,47 @@ void parseModeStatus(const uint8_t* data, uint8_t len) {
     logModeChange(modeByte);
 }
 
-void parseSpeedAndTemp(const uint8_t* data, uint8_t len) {
-    vehicleData.speedKmh = data[3];
-    vehicleData.speedValid = true;
+void applySpeed() {
+    vehicleData.speedKmh = (uint16_t)canSignals[CANSIG_SPEED];
+    markSignal(SIGNAL_SPEED);
+    foxTripOnSpeed(vehicleData.speedKmh, signalArrivalMs);
 }
 
-void parseBatteryTemp5S(const uint8_t* data, uint8_t len) {
+void applyBatteryTemp5S() {
     uint8_t maxTemp = 0;
-    for(int i = 0; i < 5; ++i) {
-        if(data[i] > maxTemp) maxTemp = data[i];
+    for(int i = CANSIG_BATT_TEMP_1; i <= CANSIG_BATT_TEMP_5; ++i) {
+        uint8_t temp = (uint8_t)canSignals[i];
+        if(temp > maxTemp) maxTemp = temp;
     }
     vehicleData.tempBattery = maxTemp;
-    vehicleData.tempValid = true;
+    markSignal(SIGNAL_TEMP_BATTERY);
 }
 
-void parseBatteryTempSingle(const uint8_t* data, uint8_t len) {
-    uint8_t battTemp = data[5];
-    if(battTemp > vehicleData.tempBattery) {
+void applyBatteryTempSingle() {
+    uint8_t battTemp = (uint8_t)canSignals[CANSIG_BATT_TEMP_SGL];
+    // Suhu baterai stale tidak ikut dibandingkan
+    if(battTemp > vehicleData.tempBattery || !foxSignalValid(vehicleData, SIGNAL_TEMP_BATTERY)) {
         vehicleData.tempBattery = battTemp;
-        vehicleData.tempValid = true;
+        markSignal(SIGNAL_TEMP_BATTERY);
     }
 }
 
+// Unknown ID dicatat ke tabel sniffer (O(1), tanpa print per frame), lihat command SNIFF
 void captureUnknownCANData(uint32_t canId, const uint8_t* data, uint8_t len) {
-    if(canId != 0x00000000 && canId != 0xFFFFFFFF && captureUnknownCAN) {
-        static uint32_t lastUnknownCANId = 0;
-        static unsigned long lastCaptureLog = 0;
-        
-        if(canId != lastUnknownCANId || millis() - lastCaptureLog > 30000) {
-            Serial.print("UNKNOWN CAN ID: 0x");
-            Serial.print(canId, HEX);
-            Serial.print(" Len:");
-            Serial.print(len);
-            Serial.print(" Data:");
-            
-            for(int i = 0; i < len && i < 8; i++) {
-                Serial.print(" ");
-                if(data[i] < 0x10) Serial.print("0");
-                Serial.print(data[i], HEX);
-            }
-            Serial.println();
-            
-            lastUnknownCANId = canId;
-            lastCaptureLog = millis();
-        }
+    if(captureUnknownCAN) {
+        foxSnifferRecord(canId, data, len);
     }
 }
 
+// Dipanggil sekali per byte (bitmap seen), lihat noteUnknownModeByte()
 void logUnknownMode(uint8_t modeByte) {
-    // Hanya log pertama kali untuk setiap byte
-    if (!isByteAlreadySeen(modeByte)) {
-        Serial.print("[UNKNOWN] Mode Byte: 0x");
-        if(modeByte < 0x10) Serial.print("0");
-        Serial.print(modeByte, HEX);
-        Serial.print(" (");
-        Serial.print(modeByte);
-        Serial.print(") - Using fallback: ");
-        Serial.println(foxVehicleModeToString(determineSafeFallback(modeByte)));
-    }
+    Serial.print("[UNKNOWN] Mode Byte: 0x");
+    if(modeByte < 0x10) Serial.print("0");
+    Serial.print(modeByte, HEX);
+    Serial.print(" (");
+    Serial.print(modeByte);
+    Serial.print(") - Using fallback: ");
+    Serial.println(foxVehicleModeToString(determineSafeFallback(modeByte)));
 }
 
 void logModeChange(uint8_t modeByte) {
@@ -415,34 +626,111 @@ void logModeChange(uint8_t modeByte) {
 }
 
 // Fungsi publik
+void foxVehicleProcess() {
+    processMailboxes();
+}
+
 FoxVehicleData foxVehicleGetData() {
-    return vehicleData;
+    FoxVehicleData data;
+    processMailboxes();
+    foxVehicleReadSnapshot(data);
+    return data;
+}
+
+// Tanpa copy. Hanya untuk task yang sama dengan decode (loop), isi berubah
+// saat publish berikutnya.
+const FoxVehicleData& foxVehicleGetDataRef() {
+    processMailboxes();
+    return vehicleSnapshot;
+}
+
+// Aman dari task/core lain: ulangi copy sampai tidak ada publish di tengahnya.
+// Tidak memicu decode, hanya membaca hasil publish terakhir.
+uint32_t foxVehicleReadSnapshot(FoxVehicleData& out) {
+    for(;;) {
+        uint32_t before = vehicleSeq.load(std::memory_order_acquire);
+        if(before & 1) continue;
+        out = vehicleSnapshot;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(vehicleSeq.load(std::memory_order_relaxed) == before) {
+            return before >> 1;
+        }
+    }
+}
+
+// Naik setiap kali snapshot dipublish, untuk cek "tidak ada perubahan" tanpa copy
+uint32_t foxVehicleGetGeneration() {
+    return vehicleSeq.load(std::memory_order_acquire) >> 1;
+}
+
+float foxVehicleGetSignal(FoxCANSignal signal) {
+    processMailboxes();
+    if(signal >= CANSIG_COUNT) return 0.0f;
+    return canSignals[signal];
+}
+
+// Jumlah payload yang tertimpa di mailbox sebelum sempat di-decode
+uint32_t foxVehicleGetSupersededCount(uint8_t message) {
+    if(message >= FOX_CAN_MESSAGE_COUNT) return 0;
+    return canMailboxes[message].superseded;
+}
+
+void foxVehicleResetSupersededCounts() {
+    for(uint8_t i = 0; i < FOX_CAN_MESSAGE_COUNT; i++) {
+        canMailboxes[i].superseded = 0;
+    }
 }
 
 bool foxVehicleIsSportMode() {
-    return vehicleData.sportActive;
+    processMailboxes();
+    return vehicleSnapshot.sportActive;
 }
 
+// Hanya menandakan bus hidup (ID known apa saja), pakai foxVehicleSignalAge() per signal
 bool foxVehicleDataIsFresh(unsigned long timeoutMs) {
     return (millis() - vehicleData.lastUpdate) < timeoutMs;
 }
 
-String foxVehicleModeToString(FoxVehicleMode mode) {
-    switch(mode) {
-        case MODE_PARK: return "PARK";
-        case MODE_DRIVE: return "DRIVE";
-        case MODE_SPORT: return "SPORT";
-        case MODE_CUTOFF: return "CUTOFF";
-        case MODE_STANDBY: return "STAND";
-        case MODE_REVERSE: return "REVERSE";
-        case MODE_NEUTRAL: return "NEUTRAL";
-        case MODE_CRUISE: return "DRIVE+CRUISE";
-        case MODE_SPORT_CRUISE: return "SPORT+CRUISE";
-        case MODE_CHARGING: return "CHARGING";
+// Umur (ms) frame terakhir yang membawa signal, FOX_SIGNAL_AGE_NEVER jika belum pernah
+unsigned long foxVehicleSignalAge(FoxVehicleSignal signal) {
+    if(signal >= SIGNAL_COUNT || !(signalSeenMask & (1u << signal))) {
+        return FOX_SIGNAL_AGE_NEVER;
+    }
+    return millis() - vehicleData.signalTime[signal];
+}
+
+bool foxVehicleSignalIsValid(FoxVehicleSignal signal) {
+    processMailboxes();
+    return signal < SIGNAL_COUNT && foxSignalValid(vehicleSnapshot, signal);
+}
+
+const char* foxVehicleSignalName(FoxVehicleSignal signal) {
+    switch(signal) {
+        case SIGNAL_MODE: return "MODE";
+        case SIGNAL_RPM: return "RPM";
+        case SIGNAL_SPEED: return "SPEED";
+        case SIGNAL_TEMP_CONTROLLER: return "TEMP_ECU";
+        case SIGNAL_TEMP_MOTOR: return "TEMP_MOTOR";
+        case SIGNAL_TEMP_BATTERY: return "TEMP_BATT";
+        case SIGNAL_VOLTAGE: return "VOLTAGE";
+        case SIGNAL_CURRENT: return "CURRENT";
+        case SIGNAL_SOC: return "SOC";
         default: return "UNKNOWN";
     }
 }
 
+// Urutan sama dengan FoxVehicleMode
+static const char* const modeNames[] = {
+    "UNKNOWN", "PARK", "DRIVE", "SPORT", "CUTOFF", "STAND",
+    "REVERSE", "NEUTRAL", "DRIVE+CRUISE", "SPORT+CRUISE", "CHARGING"
+};
+static_assert(sizeof(modeNames) / sizeof(modeNames[0]) == MODE_CHARGING + 1, "modeNames tidak sesuai FoxVehicleMode");
+
+const char* foxVehicleModeToString(FoxVehicleMode mode) {
+    if((unsigned)mode >= sizeof(modeNames) / sizeof(modeNames[0])) return modeNames[MODE_UNKNOWN];
+    return modeNames[mode];
+}
+
 void foxVehicleEnableUnknownCapture(bool enable) {
     captureUnknownCAN = enable;
     if(enable) {
@@ -452,9 +740,60 @@ void foxVehicleEnableUnknownCapture(bool enable) {
     }
 }
 
-// Fungsi untuk clear unknown bytes list
+float foxVehicleSignalValue(const FoxVehicleData& data, FoxVehicleSignal signal) {
+    switch(signal) {
+        case SIGNAL_MODE: return data.mode;
+        case SIGNAL_RPM: return data.rpm;
+        case SIGNAL_SPEED: return data.speedKmh;
+        case SIGNAL_TEMP_CONTROLLER: return data.tempController;
+        case SIGNAL_TEMP_MOTOR: return data.tempMotor;
+        case SIGNAL_TEMP_BATTERY: return data.tempBattery;
+        case SIGNAL_VOLTAGE: return data.voltage;
+        case SIGNAL_CURRENT: return data.current;
+        case SIGNAL_SOC: return data.soc;
+        default: return 0.0f;
+    }
+}
+
+bool foxVehicleIsKnownModeByte(uint8_t modeByte) {
+    return !(modeByteTable.entry[modeByte] & MODE_CLASS_UNKNOWN);
+}
+
+// Simpan unknown mode byte ke NVS: byte baru langsung, count berkala
+void foxVehicleUpdate() {
+    if(!unknownModeDirty) return;
+    if(unknownModeNew || millis() - unknownModeLastSaveMs > UNKNOWN_MODE_SAVE_MS) {
+        saveUnknownModes();
+    }
+}
+
+// Fungsi untuk clear unknown bytes list (RAM dan NVS)
 void foxVehicleClearUnknownList() {
-    memset(unknownBytesSeen, 0, sizeof(unknownBytesSeen));
-    unknownBytesCount = 0;
+    resetUnknownModes();
+    saveUnknownModes();
     Serial.println("Unknown bytes list cleared");
 }
+
+void foxVehiclePrintUnknownModes() {
+    foxVehicleProcess();
+    Serial.println("=== UNKNOWN MODE BYTES ===");
+    for(uint8_t i = 0; i < unknownModes.count; i++) {
+        const UnknownModeRecord& rec = unknownModes.records[i];
+        Serial.printf("0x%02X  count %-8lu first ", rec.modeByte, (unsigned long)rec.count);
+        if(rec.firstSeen.year > 0) {
+            Serial.printf("%04u-%02u-%02u %02u:%02u:%02u", rec.firstSeen.year, rec.firstSeen.month,
+                          rec.firstSeen.day, rec.firstSeen.hour, rec.firstSeen.minute, rec.firstSeen.second);
+        } else {
+            Serial.print("--");
+        }
+        Serial.print("  fallback ");
+        Serial.println(foxVehicleModeToString(determineSafeFallback(rec.modeByte)));
+    }
+    Serial.print("Learned: ");
+    Serial.print(unknownModes.count);
+    Serial.print("/");
+    Serial.print(UNKNOWN_MODE_MAX_RECORDS);
+    Serial.print(", dropped: ");
+    Serial.println(unknownModeDropped);
+    Serial.println("==========================");
+}
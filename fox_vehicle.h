@@ -3,6 +3,24 @@
 
 #include <Arduino.h>
 #include "fox_config.h"
+#include "fox_candb.h"
+
+// Signal kendaraan yang punya timestamp & timeout sendiri
+enum FoxVehicleSignal {
+    SIGNAL_MODE = 0,
+    SIGNAL_RPM,
+    SIGNAL_SPEED,
+    SIGNAL_TEMP_CONTROLLER,
+    SIGNAL_TEMP_MOTOR,
+    SIGNAL_TEMP_BATTERY,
+    SIGNAL_VOLTAGE,
+    SIGNAL_CURRENT,
+    SIGNAL_SOC,
+    SIGNAL_COUNT
+};
+
+// Umur signal yang belum pernah diterima
+#define FOX_SIGNAL_AGE_NEVER 0xFFFFFFFFUL
 
 // Definisi struct
 struct FoxVehicleData {
@@ -25,33 +43,52 @@ struct FoxVehicleData {
     float current;
     uint8_t soc;
     
-    // Timestamp
+    // Timestamp frame known terakhir (ID apa saja)
     unsigned long lastUpdate;
     
-    // Data validity flags
-    bool rpmValid : 1;
-    bool speedValid : 1;
-    bool tempValid : 1;
-    bool voltageValid : 1;
-    bool socValid : 1;
+    // Validity per signal (bit = FoxVehicleSignal), dihapus saat timeout
+    uint16_t validMask;
+    
+    // millis() saat frame pembawa signal tiba
+    unsigned long signalTime[SIGNAL_COUNT];
 };
 
+inline bool foxSignalValid(const FoxVehicleData& data, FoxVehicleSignal signal) {
+    return (data.validMask & (1u << signal)) != 0;
+}
+
 // Function prototypes
 void foxVehicleInit();
-void foxVehicleUpdateFromCAN(uint32_t canId, const uint8_t* data, uint8_t len);
+void foxVehicleUpdateFromCAN(uint32_t canId, const uint8_t* data, uint8_t len, uint32_t timestampUs);
+void foxVehicleProcess();
 FoxVehicleData foxVehicleGetData();
+const FoxVehicleData& foxVehicleGetDataRef();
+uint32_t foxVehicleReadSnapshot(FoxVehicleData& out);
+uint32_t foxVehicleGetGeneration();
+float foxVehicleGetSignal(FoxCANSignal signal);
+uint32_t foxVehicleGetSupersededCount(uint8_t message);
+void foxVehicleResetSupersededCounts();
 bool foxVehicleIsSportMode();
 bool foxVehicleDataIsFresh(unsigned long timeoutMs = 1000);
-String foxVehicleModeToString(FoxVehicleMode mode);
+unsigned long foxVehicleSignalAge(FoxVehicleSignal signal);
+bool foxVehicleSignalIsValid(FoxVehicleSignal signal);
+const char* foxVehicleSignalName(FoxVehicleSignal signal);
+float foxVehicleSignalValue(const FoxVehicleData& data, FoxVehicleSignal signal);
+const char* foxVehicleModeToString(FoxVehicleMode mode);
 void foxVehicleEnableUnknownCapture(bool enable);
+bool foxVehicleIsKnownModeByte(uint8_t modeByte);
+void foxVehicleUpdate();
+void foxVehicleClearUnknownList();
+void foxVehiclePrintUnknownModes();
 
 // Deklarasi fungsi helper internal
-void parseModeStatus(const uint8_t* data, uint8_t len);
-void parseSpeedAndTemp(const uint8_t* data, uint8_t len);
-void parseBatteryTemp5S(const uint8_t* data, uint8_t len);
-void parseBatteryTempSingle(const uint8_t* data, uint8_t len);
-void parseVoltageCurrent(const uint8_t* data, uint8_t len);
-void parseSOC(const uint8_t* data, uint8_t len);
+// (dipanggil setelah signal message di-decode dari FOX_CAN_SIGNALS)
+void applyModeStatus();
+void applySpeed();
+void applyBatteryTemp5S();
+void applyBatteryTempSingle();
+void applyVoltageCurrent();
+void applySOC();
 void captureUnknownCANData(uint32_t canId, const uint8_t* data, uint8_t len);
 void logUnknownMode(uint8_t modeByte);
 void logModeChange(uint8_t modeByte);
@@ -0,0 +1,156 @@
+// =============================================
+// MICROBENCHMARK CAN DECODE HOT PATH (host Linux)
+// =============================================
+// Mengukur ns/frame foxVehicleUpdateFromCAN() untuk beberapa campuran frame.
+// Varian "Read" juga memanggil foxVehicleGetData() tiap frame supaya decode
+// mailbox (lazy) ikut terukur.
+//
+// JSON: fox_bench --benchmark_format=json  (atau target "bench_json")
+
+#include <Arduino.h>
+#include "fox_vehicle.h"
+#include "fox_history.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// ID charger/BMS yang tidak ada di whitelist (lihat fox_candb.h)
+#define BENCH_CAN_CHARGER_1 0x1806E5F4UL
+#define BENCH_CAN_CHARGER_2 0x18FF50E5UL
+
+struct BenchFrame {
+    uint32_t canId;
+    uint8_t len;
+    uint8_t data[8];
+};
+
+static BenchFrame makeFrame(uint32_t canId, std::initializer_list<uint8_t> bytes) {
+    BenchFrame f = {canId, (uint8_t)bytes.size(), {0}};
+    uint8_t i = 0;
+    for(uint8_t b : bytes) f.data[i++] = b;
+    return f;
+}
+
+// Campuran frame normal saat berkendara, rasio kira-kira seperti di bus
+static std::vector<BenchFrame> knownMix() {
+    std::vector<BenchFrame> frames;
+    for(int i = 0; i < 8; i++) {
+        uint8_t mode = (i & 1) ? MODE_BYTE_SPORT : MODE_BYTE_DRIVE;
+        frames.push_back(makeFrame(FOX_CAN_MODE_STATUS, {0x00, mode, (uint8_t)(0x10 + i), 0x07, 0x3C, 0x41, 0x00, 0x00}));
+        frames.push_back(makeFrame(FOX_CAN_TEMP_CTRL_MOT, {0x00, 0x00, 0x00, (uint8_t)(40 + i), 0x00, 0x00, 0x00, 0x00}));
+    }
+    frames.push_back(makeFrame(FOX_CAN_VOLTAGE, {0x02, 0xD0, 0xFF, 0x9C}));
+    frames.push_back(makeFrame(FOX_CAN_VOLTAGE, {0x02, 0xCF, 0xFF, 0x90}));
+    frames.push_back(makeFrame(FOX_CAN_SOC, {0x01, 0x90}));
+    frames.push_back(makeFrame(FOX_CAN_TEMP_BATT_5S, {0x00, 0x00, 0x00, 0x00, 0x1E, 0x1F, 0x20, 0x1E}));
+    frames.push_back(makeFrame(FOX_CAN_TEMP_BATT_SGL, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21}));
+    return frames;
+}
+
+static std::vector<BenchFrame> unknownIds() {
+    std::vector<BenchFrame> frames;
+    for(uint32_t i = 0; i < 64; i++) {
+        frames.push_back(makeFrame(0x10000000UL + i * 0x1111UL, {(uint8_t)i, 1, 2, 3, 4, 5, 6, 7}));
+    }
+    return frames;
+}
+
+// Charger kirim frame status rapat, diselingi mode status charging
+static std::vector<BenchFrame> chargerFlood() {
+    std::vector<BenchFrame> frames;
+    for(int i = 0; i < 16; i++) {
+        frames.push_back(makeFrame(BENCH_CAN_CHARGER_1, {0x02, 0xEE, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00}));
+        frames.push_back(makeFrame(BENCH_CAN_CHARGER_2, {0x02, 0xD0, 0x00, 0x5A, 0x00, 0x00, 0x00, 0x00}));
+    }
+    frames.push_back(makeFrame(FOX_CAN_MODE_STATUS, {0x00, MODE_BYTE_CHARGING_1, 0x00, 0x00, 0x1E, 0x1E, 0x00, 0x00}));
+    frames.push_back(makeFrame(FOX_CAN_VOLTAGE, {0x02, 0xEE, 0x00, 0x64}));
+    return frames;
+}
+
+// Byte mode unknown, lebih banyak dari kapasitas record unknown
+static std::vector<BenchFrame> unknownModeBytes() {
+    std::vector<BenchFrame> frames;
+    for(int b = 0; b < 256 && frames.size() < 64; b++) {
+        if(foxVehicleIsKnownModeByte(b)) continue;
+        frames.push_back(makeFrame(FOX_CAN_MODE_STATUS, {0x00, (uint8_t)b, 0x10, 0x07, 0x3C, 0x41, 0x00, 0x00}));
+    }
+    return frames;
+}
+
+static void resetVehicle(bool capture) {
+    Serial.setOutput(nullptr);
+    hostClockSetMicros(1000000ULL);
+    foxVehicleInit();
+    foxVehicleClearUnknownList();
+    foxVehicleEnableUnknownCapture(capture);
+}
+
+// stepUs: jarak antar frame di clock virtual (bus 250 kbps penuh ~ 500 us/frame)
+static void runFrames(benchmark::State& state, const std::vector<BenchFrame>& frames,
+                      bool capture, bool read, uint32_t stepUs) {
+    resetVehicle(capture);
+    size_t i = 0;
+    for(auto _ : state) {
+        const BenchFrame& f = frames[i];
+        if(++i == frames.size()) i = 0;
+        hostClockAdvanceMicros(stepUs);
+        foxVehicleUpdateFromCAN(f.canId, f.data, f.len, micros());
+        if(read) {
+            FoxVehicleData data = foxVehicleGetData();
+            benchmark::DoNotOptimize(data);
+        }
+    }
+    // Satu iterasi = satu frame, jadi real_time/cpu_time di JSON sudah ns/frame
+    state.SetItemsProcessed(state.iterations());
+    foxVehicleEnableUnknownCapture(false);
+}
+
+static void BM_KnownMix(benchmark::State& state) {
+    runFrames(state, knownMix(), false, false, 500);
+}
+BENCHMARK(BM_KnownMix);
+
+static void BM_KnownMixRead(benchmark::State& state) {
+    runFrames(state, knownMix(), false, true, 500);
+}
+BENCHMARK(BM_KnownMixRead);
+
+static void BM_UnknownIdsCaptureOff(benchmark::State& state) {
+    runFrames(state, unknownIds(), false, false, 500);
+}
+BENCHMARK(BM_UnknownIdsCaptureOff);
+
+static void BM_UnknownIdsCaptureOn(benchmark::State& state) {
+    runFrames(state, unknownIds(), true, false, 500);
+}
+BENCHMARK(BM_UnknownIdsCaptureOn);
+
+static void BM_ChargerFlood(benchmark::State& state) {
+    runFrames(state, chargerFlood(), false, true, 500);
+}
+BENCHMARK(BM_ChargerFlood);
+
+// Clock maju 10 ms per frame supaya setiap frame mode benar-benar di-decode
+static void BM_UnknownModeBytes(benchmark::State& state) {
+    runFrames(state, unknownModeBytes(), false, true, CAN_DECODE_INTERVAL_MODE_MS * 1000);
+}
+BENCHMARK(BM_UnknownModeBytes);
+
+// Satu iterasi = satu sample history 10 Hz (termasuk penutupan bucket 1 s / 5 menit)
+static void BM_HistorySample(benchmark::State& state) {
+    std::vector<BenchFrame> frames = knownMix();
+    resetVehicle(false);
+    foxHistoryClear();
+    size_t i = 0;
+    for(auto _ : state) {
+        const BenchFrame& f = frames[i];
+        if(++i == frames.size()) i = 0;
+        hostClockAdvanceMicros(HISTORY_T0_PERIOD_MS * 1000UL);
+        foxVehicleUpdateFromCAN(f.canId, f.data, f.len, micros());
+        foxHistoryUpdate();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HistorySample);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,391 @@
+// =============================================
+// HEADLESS DISPLAY RENDERER (host Linux)
+// =============================================
+// Menjalankan fungsi page fox_display.cpp di atas framebuffer SSD1306 di memori
+// (Adafruit_GFX asli + shim Adafruit_SSD1306), dengan RTC palsu dan data kendaraan
+// dari frame CAN sintetis. Setiap skenario:
+//   - snapshot PBM (P1, 1 = pixel menyala) ke --out
+//   - dibandingkan dengan golden <nama>.pbm di --golden (--update menulis ulang golden)
+//   - diukur waktu render (us/frame, waktu nyata; clock firmware tetap virtual)
+//     dan jumlah alokasi heap selama pengukuran (harus 0)
+// Skenario dengan digit dari glyph cache (jam, speed) dirender ulang lewat Adafruit_GFX
+// (baris <nama>/gfx) dan harus identik pixel per pixel dengan hasil blit. Golden
+// skenario ini ditulis dari render Adafruit_GFX, bukan dari cache.
+// Exit code 1 jika ada golden yang berbeda / tidak ada, atau cache berbeda dari GFX.
+
+#include <Arduino.h>
+#include "fox_config.h"
+#include "fox_display.h"
+#include "fox_i2c.h"
+#include "fox_rtc.h"
+#include "fox_vehicle.h"
+#include "fox_trip.h"
+#include "fox_heap.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <sys/stat.h>
+
+#define RENDER_START_US 1000000ULL
+#define FRAME_BYTES (SCREEN_WIDTH * SCREEN_HEIGHT / 8)
+
+struct RenderOptions {
+    const char* outDir = "render_out";
+    const char* goldenDir = nullptr;
+    const char* only = nullptr;
+    bool update = false;
+    bool quiet = true;
+    bool glyphCache = true;
+    unsigned long iterations = 2000;
+};
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --out DIR        folder snapshot PBM (default render_out)\n"
+            "  --golden DIR     bandingkan dengan DIR/<skenario>.pbm\n"
+            "  --update         tulis snapshot sebagai golden baru (butuh --golden)\n"
+            "  --only NAME      hanya satu skenario\n"
+            "  --iterations N   jumlah render untuk pengukuran (default 2000, 0 = tanpa)\n"
+            "  --no-glyph-cache semua digit lewat Adafruit_GFX (tanpa baris /gfx)\n"
+            "  --verbose        tampilkan output Serial firmware di stderr\n",
+            argv0);
+}
+
+// ========== RTC PALSU ==========
+// Menggantikan fox_rtc.cpp: waktu tetap supaya snapshot page jam deterministik
+static RTCDateTime fakeClock = {2024, 8, 17, 9, 41, 27, 7};
+
+RTCDateTime foxRTCGetDateTime() {
+    return fakeClock;
+}
+
+// ========== DATA KENDARAAN ==========
+static void sendFrame(uint32_t canId, std::initializer_list<uint8_t> bytes) {
+    uint8_t data[8] = {0};
+    uint8_t len = 0;
+    for(uint8_t b : bytes) {
+        if(len < 8) data[len++] = b;
+    }
+    foxVehicleUpdateFromCAN(canId, data, len, micros());
+}
+
+// Mode + RPM + suhu ECU/motor
+static void sendModeStatus(uint8_t modeByte, uint16_t rpm, uint8_t tempCtrl, uint8_t tempMotor) {
+    sendFrame(FOX_CAN_MODE_STATUS, {0x00, modeByte, (uint8_t)(rpm & 0xFF), (uint8_t)(rpm >> 8),
+                                    tempCtrl, tempMotor, 0x00, 0x00});
+}
+
+static void sendSpeed(uint8_t speedKmh) {
+    sendFrame(FOX_CAN_TEMP_CTRL_MOT, {0x00, 0x00, 0x00, speedKmh, 0x00, 0x00});
+}
+
+// Motorola 16 bit, 0.1 V / 0.1 A; arus negatif = discharge
+static void sendVoltageCurrent(float voltage, float current) {
+    uint16_t v = (uint16_t)(voltage * 10.0f + 0.5f);
+    int16_t c = (int16_t)(current * 10.0f + (current < 0 ? -0.5f : 0.5f));
+    sendFrame(FOX_CAN_VOLTAGE, {(uint8_t)(v >> 8), (uint8_t)v, (uint8_t)((uint16_t)c >> 8), (uint8_t)c});
+}
+
+static void sendBatteryTemp(uint8_t temp) {
+    sendFrame(FOX_CAN_TEMP_BATT_5S, {temp, temp, temp, temp, temp});
+}
+
+// Maju waktu lalu baca data supaya mailbox di-decode (interval decode per ID)
+static void settle() {
+    hostClockAdvanceMicros(1000000ULL);
+    foxVehicleGetDataRef();
+}
+
+// Berkendara konstan selama seconds detik (frame tiap 100 ms), mengisi akumulator trip
+static void drive(uint8_t speedKmh, float voltage, float current, unsigned long seconds) {
+    for(unsigned long i = 0; i < seconds * 10; i++) {
+        sendModeStatus(MODE_BYTE_DRIVE, 2400, 48, 55);
+        sendSpeed(speedKmh);
+        sendVoltageCurrent(voltage, current);
+        hostClockAdvanceMicros(100000ULL);
+        foxVehicleGetDataRef();
+    }
+}
+
+// Fase kedip dimulai dari awal fase "menyala"
+static void alignBlinkOn() {
+    uint64_t period = 2ULL * BLINK_INTERVAL_MS * 1000;
+    uint64_t now = hostClockMicros();
+    hostClockSetMicros((now / period + 1) * period);
+}
+
+// ========== SKENARIO ==========
+// Urutan penting: data kendaraan menumpuk dari skenario sebelumnya
+struct RenderScenario {
+    const char* name;
+    int page;                   // -1 = layar setup
+    void (*prepare)();
+    bool cachedDigits;          // Page memakai glyph cache (dibandingkan dengan Adafruit_GFX)
+};
+
+static void prepareNothing() {}
+
+static void prepareTemp() {
+    sendModeStatus(MODE_BYTE_DRIVE, 0, 45, 52);
+    sendBatteryTemp(31);
+    settle();
+}
+
+static void prepareElectricalDischarge() {
+    sendVoltageCurrent(81.6f, -23.4f);
+    settle();
+}
+
+static void prepareElectricalRegen() {
+    sendVoltageCurrent(84.2f, 6.5f);
+    settle();
+}
+
+static void prepareTrip() {
+    drive(40, 80.0f, -18.0f, 180);
+}
+
+static void prepareSportLow() {
+    sendModeStatus(MODE_BYTE_SPORT, 3200, 50, 58);
+    sendSpeed(45);
+    settle();
+}
+
+static void prepareSportHigh() {
+    sendModeStatus(MODE_BYTE_SPORT, 6100, 52, 61);
+    sendSpeed(97);
+    settle();
+}
+
+static void prepareCruise() {
+    sendModeStatus(MODE_BYTE_CRUISE, 4000, 50, 58);
+    sendSpeed(60);
+    settle();
+    alignBlinkOn();
+}
+
+static void prepareCharging() {
+    sendModeStatus(MODE_BYTE_CHARGING_1, 0, 30, 30);
+    sendVoltageCurrent(82.0f, 9.8f);
+    settle();
+}
+
+static const RenderScenario scenarios[] = {
+    { "clock",              PAGE_CLOCK,      prepareNothing,             true },
+    { "temp_stale",         PAGE_TEMP,       prepareNothing,             false },
+    { "temp",               PAGE_TEMP,       prepareTemp,                false },
+    { "electrical",         PAGE_ELECTRICAL, prepareElectricalDischarge, false },
+    { "electrical_regen",   PAGE_ELECTRICAL, prepareElectricalRegen,     false },
+    { "trip",               PAGE_TRIP,       prepareTrip,                false },
+    { "sport_low",          PAGE_SPORT,      prepareSportLow,            true },
+    { "sport_high",         PAGE_SPORT,      prepareSportHigh,           true },
+    { "cruise",             PAGE_SPORT,      prepareCruise,              true },
+    { "charging",           PAGE_CHARGING,   prepareCharging,            false },
+    { "setup",              -1,              prepareNothing,             false },
+};
+
+static void renderScenario(const RenderScenario& s) {
+    if(s.page < 0) {
+        foxDisplayShowSetupMode(true);
+    } else {
+        foxDisplayRenderPage(s.page);
+    }
+}
+
+// Render ulang berkali-kali dengan input sama (waktu virtual tidak maju)
+static double measureScenario(const RenderScenario& s, unsigned long iterations, uint32_t& allocs) {
+    uint32_t allocsBefore = foxHeapGetStats().allocs;
+    double usPerFrame = 0;
+    if(iterations > 0) {
+        auto start = std::chrono::steady_clock::now();
+        for(unsigned long i = 0; i < iterations; i++) {
+            renderScenario(s);
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        usPerFrame = elapsed.count() / iterations;
+    }
+    allocs = foxHeapGetStats().allocs - allocsBefore;
+    return usPerFrame;
+}
+
+// ========== PBM ==========
+static bool framePixel(const uint8_t* frame, int x, int y) {
+    return (frame[x + (y / 8) * SCREEN_WIDTH] >> (y & 7)) & 1;
+}
+
+static std::string joinPath(const char* dir, const char* name) {
+    std::string path(dir);
+    if(!path.empty() && path.back() != '/') path += '/';
+    return path + name + ".pbm";
+}
+
+static bool writePBM(const std::string& path, const uint8_t* frame) {
+    FILE* f = fopen(path.c_str(), "w");
+    if(!f) {
+        perror(path.c_str());
+        return false;
+    }
+    fprintf(f, "P1\n%d %d\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+    for(int y = 0; y < SCREEN_HEIGHT; y++) {
+        for(int x = 0; x < SCREEN_WIDTH; x++) {
+            fputc(framePixel(frame, x, y) ? '1' : '0', f);
+        }
+        fputc('\n', f);
+    }
+    fclose(f);
+    return true;
+}
+
+// Fungsi: Baca PBM P1 ke framebuffer format page; false jika tidak ada / ukuran beda
+static bool readPBM(const std::string& path, uint8_t* frame) {
+    FILE* f = fopen(path.c_str(), "r");
+    if(!f) return false;
+
+    char magic[3] = {0};
+    int w = 0, h = 0;
+    bool ok = fscanf(f, "%2s %d %d", magic, &w, &h) == 3 && strcmp(magic, "P1") == 0 &&
+              w == SCREEN_WIDTH && h == SCREEN_HEIGHT;
+    memset(frame, 0, FRAME_BYTES);
+    for(int i = 0; ok && i < w * h; i++) {
+        int c;
+        do { c = fgetc(f); } while(c == ' ' || c == '\n' || c == '\r' || c == '\t');
+        if(c != '0' && c != '1') {
+            ok = false;
+            break;
+        }
+        int x = i % w, y = i / w;
+        if(c == '1') frame[x + (y / 8) * SCREEN_WIDTH] |= 1 << (y & 7);
+    }
+    fclose(f);
+    return ok;
+}
+
+static int countDiff(const uint8_t* a, const uint8_t* b) {
+    int diff = 0;
+    for(int i = 0; i < FRAME_BYTES; i++) {
+        diff += __builtin_popcount(a[i] ^ b[i]);
+    }
+    return diff;
+}
+
+// ========== MAIN ==========
+int main(int argc, char** argv) {
+    RenderOptions opt;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--out") == 0 && i + 1 < argc) opt.outDir = argv[++i];
+        else if(strcmp(argv[i], "--golden") == 0 && i + 1 < argc) opt.goldenDir = argv[++i];
+        else if(strcmp(argv[i], "--only") == 0 && i + 1 < argc) opt.only = argv[++i];
+        else if(strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) opt.iterations = strtoul(argv[++i], nullptr, 10);
+        else if(strcmp(argv[i], "--update") == 0) opt.update = true;
+        else if(strcmp(argv[i], "--no-glyph-cache") == 0) opt.glyphCache = false;
+        else if(strcmp(argv[i], "--verbose") == 0) opt.quiet = false;
+        else { usage(argv[0]); return 2; }
+    }
+    if(opt.update && !opt.goldenDir) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    mkdir(opt.outDir, 0755);
+    if(opt.update) mkdir(opt.goldenDir, 0755);
+
+    Serial.setOutput(opt.quiet ? nullptr : stderr);
+    hostClockSetMicros(RENDER_START_US);
+    foxI2CInit();
+    foxVehicleInit();
+    foxTripInit();
+    foxDisplayInit();
+    if(!foxDisplayIsInitialized()) {
+        fprintf(stderr, "render: foxDisplayInit() gagal\n");
+        return 1;
+    }
+    bool glyphCache = foxDisplaySetGlyphCache(opt.glyphCache);
+    if(opt.glyphCache && !glyphCache) {
+        fprintf(stderr, "render: glyph cache tidak aktif, digit lewat Adafruit_GFX\n");
+    }
+
+    printf("%-18s %10s %7s  %s\n", "scenario", "us/frame", "allocs", "golden");
+    int failures = 0;
+    int missing = 0;
+    uint8_t golden[FRAME_BYTES];
+
+    for(const RenderScenario& s : scenarios) {
+        s.prepare();
+        if(opt.only && strcmp(opt.only, s.name) != 0) continue;
+
+        renderScenario(s);
+
+        uint8_t frame[FRAME_BYTES];
+        memcpy(frame, foxDisplayGetFrame(), FRAME_BYTES);
+        writePBM(joinPath(opt.outDir, s.name), frame);
+
+        uint32_t allocs = 0;
+        double usPerFrame = measureScenario(s, opt.iterations, allocs);
+
+        // Pasangan tanpa cache: frame referensi dari Adafruit_GFX
+        bool haveReference = glyphCache && s.cachedDigits;
+        uint8_t reference[FRAME_BYTES];
+        uint32_t referenceAllocs = 0;
+        double referenceUs = 0;
+        if(haveReference) {
+            foxDisplaySetGlyphCache(false);
+            renderScenario(s);
+            memcpy(reference, foxDisplayGetFrame(), FRAME_BYTES);
+            referenceUs = measureScenario(s, opt.iterations, referenceAllocs);
+            foxDisplaySetGlyphCache(true);
+        }
+
+        const char* status = "-";
+        char diffText[32];
+        if(opt.goldenDir) {
+            std::string goldenPath = joinPath(opt.goldenDir, s.name);
+            if(opt.update) {
+                status = writePBM(goldenPath, haveReference ? reference : frame) ? "updated" : "WRITE FAILED";
+            } else if(!readPBM(goldenPath, golden)) {
+                status = "MISSING";
+                failures++;
+                missing++;
+            } else {
+                int diff = countDiff(frame, golden);
+                if(diff == 0) {
+                    status = "ok";
+                } else {
+                    snprintf(diffText, sizeof(diffText), "DIFF %d px", diff);
+                    status = diffText;
+                    failures++;
+                }
+            }
+        }
+
+        printf("%-18s %10.2f %7lu  %s\n", s.name, usPerFrame, (unsigned long)allocs, status);
+
+        if(haveReference) {
+            std::string name = std::string(s.name) + "/gfx";
+            int diff = countDiff(frame, reference);
+            if(diff == 0) {
+                status = "cache = gfx";
+            } else {
+                writePBM(joinPath(opt.outDir, (std::string(s.name) + "_gfx").c_str()), reference);
+                snprintf(diffText, sizeof(diffText), "CACHE DIFF %d px", diff);
+                status = diffText;
+                failures++;
+            }
+            printf("%-18s %10.2f %7lu  %s\n", name.c_str(), referenceUs, (unsigned long)referenceAllocs, status);
+        }
+    }
+
+    if(failures > 0) {
+        fprintf(stderr, "render: %d skenario tidak sama dengan golden / Adafruit_GFX (snapshot di %s)\n",
+                failures, opt.outDir);
+        if(missing > 0) {
+            fprintf(stderr, "render: %d golden tidak ada, buat dengan target render_golden "
+                            "(Adafruit GFX versi yang dipin)\n", missing);
+        }
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,281 @@
+// =============================================
+// CAN LOG REPLAY HARNESS (host Linux)
+// =============================================
+// Memutar ulang log CAN lewat foxVehicleUpdateFromCAN() dengan clock virtual
+// dan menulis trace FoxVehicleData (CSV) ke stdout.
+//
+// Format input yang dikenali (boleh campur dalam satu file):
+//   candump -L        : (1697040000.123456) can0 0A010810#00B0112233445566
+//   candump / -t a    : (1697040000.123456)  can0  0A010810   [8]  00 B0 11 22 33 44 55 66
+//   Serial capture    : UNKNOWN CAN ID: 0xA010810 Len:8 Data: 00 B0 11 22 33 44 55 66
+// Baris tanpa timestamp memajukan clock sebesar --step-ms.
+
+#include <Arduino.h>
+#include "fox_vehicle.h"
+#include "fox_sniffer.h"
+#include "fox_trip.h"
+#include "fox_stats.h"
+#include "fox_heap.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Clock virtual dimulai dari 1 detik supaya timestamp 0 tidak dianggap "belum pernah"
+#define REPLAY_START_US 1000000ULL
+
+struct ReplayOptions {
+    const char* input = nullptr;
+    bool everyFrame = false;
+    bool capture = false;
+    bool quiet = false;
+    bool stats = false;
+    unsigned long stepMs = 10;
+};
+
+struct ReplayFrame {
+    bool hasTimestamp;
+    uint64_t timestampUs;
+    uint32_t canId;
+    uint8_t len;
+    uint8_t data[8];
+};
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "Usage: %s [options] <logfile|->\n"
+            "  --every        tulis trace setiap frame (default: hanya saat berubah)\n"
+            "  --step-ms N    langkah clock untuk baris tanpa timestamp (default 10)\n"
+            "  --capture      aktifkan CAPTURE ON, cetak report SNIFF di akhir\n"
+            "  --quiet        matikan output Serial firmware (default ke stderr)\n"
+            "  --stats        cetak report STATS di akhir\n",
+            argv0);
+}
+
+static int hexValue(char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Fungsi: Baca byte hex berurutan ("00B011" atau "00 B0 11"), maksimal 8
+static uint8_t parseHexBytes(const char* p, uint8_t* out) {
+    uint8_t count = 0;
+    while(*p && count < 8) {
+        while(*p == ' ' || *p == '\t') p++;
+        int hi = hexValue(p[0]);
+        int lo = (hi >= 0) ? hexValue(p[1]) : -1;
+        if(hi < 0 || lo < 0) break;
+        out[count++] = (uint8_t)((hi << 4) | lo);
+        p += 2;
+    }
+    return count;
+}
+
+static bool parseTimestamp(const char*& p, ReplayFrame& frame) {
+    while(*p == ' ' || *p == '\t') p++;
+    if(*p != '(') return true;
+
+    char* end = nullptr;
+    double seconds = strtod(p + 1, &end);
+    if(end == p + 1 || *end != ')') return false;
+    frame.hasTimestamp = true;
+    frame.timestampUs = (uint64_t)(seconds * 1e6 + 0.5);
+    p = end + 1;
+    return true;
+}
+
+static bool parseSerialCapture(const char* line, ReplayFrame& frame) {
+    const char* p = strstr(line, "UNKNOWN CAN ID: 0x");
+    if(!p) return false;
+
+    char* end = nullptr;
+    frame.canId = (uint32_t)strtoul(p + 18, &end, 16);
+    const char* lenPos = strstr(end, "Len:");
+    const char* dataPos = strstr(end, "Data:");
+    if(!lenPos || !dataPos) return false;
+
+    int len = atoi(lenPos + 4);
+    frame.len = parseHexBytes(dataPos + 5, frame.data);
+    return len == frame.len || (len > 8 && frame.len == 8);
+}
+
+static bool parseCandump(const char* line, ReplayFrame& frame) {
+    const char* p = line;
+    if(!parseTimestamp(p, frame)) return false;
+
+    // Nama interface
+    while(*p == ' ' || *p == '\t') p++;
+    while(*p && *p != ' ' && *p != '\t') p++;
+    while(*p == ' ' || *p == '\t') p++;
+
+    char* end = nullptr;
+    frame.canId = (uint32_t)strtoul(p, &end, 16);
+    if(end == p) return false;
+    p = end;
+
+    if(*p == '#') {
+        // candump -L: ID#DATA
+        frame.len = parseHexBytes(p + 1, frame.data);
+        return true;
+    }
+
+    // candump default: ID  [n]  bytes
+    while(*p == ' ' || *p == '\t') p++;
+    if(*p != '[') return false;
+    int len = atoi(p + 1);
+    p = strchr(p, ']');
+    if(!p || len < 0 || len > 8) return false;
+    frame.len = parseHexBytes(p + 1, frame.data);
+    return frame.len == len;
+}
+
+static bool parseLine(const char* line, ReplayFrame& frame) {
+    memset(&frame, 0, sizeof(frame));
+    if(parseSerialCapture(line, frame)) return true;
+    return parseCandump(line, frame);
+}
+
+static void printTraceHeader() {
+    printf("t_ms,mode,sport,rpm,speed_kmh,temp_ctrl,temp_motor,temp_batt,voltage,current,soc\n");
+}
+
+// Kolom signal stale dikosongkan supaya gap terlihat di trace
+static void printField(const FoxVehicleData& data, FoxVehicleSignal signal, const char* format, double value) {
+    putchar(',');
+    if(foxSignalValid(data, signal)) printf(format, value);
+}
+
+static void printTrace(const FoxVehicleData& data) {
+    printf("%lu", millis());
+    putchar(',');
+    if(foxSignalValid(data, SIGNAL_MODE)) {
+        printf("%s,%d", foxVehicleModeToString(data.mode), data.sportActive ? 1 : 0);
+    } else {
+        putchar(',');
+    }
+    printField(data, SIGNAL_RPM, "%.0f", data.rpm);
+    printField(data, SIGNAL_SPEED, "%.0f", data.speedKmh);
+    printField(data, SIGNAL_TEMP_CONTROLLER, "%.0f", data.tempController);
+    printField(data, SIGNAL_TEMP_MOTOR, "%.0f", data.tempMotor);
+    printField(data, SIGNAL_TEMP_BATTERY, "%.0f", data.tempBattery);
+    printField(data, SIGNAL_VOLTAGE, "%.1f", data.voltage);
+    printField(data, SIGNAL_CURRENT, "%.1f", data.current);
+    printField(data, SIGNAL_SOC, "%.0f", data.soc);
+    putchar('\n');
+}
+
+static bool sameTrace(const FoxVehicleData& a, const FoxVehicleData& b) {
+    return a.validMask == b.validMask && a.mode == b.mode && a.sportActive == b.sportActive && a.rpm == b.rpm &&
+           a.speedKmh == b.speedKmh && a.tempController == b.tempController &&
+           a.tempMotor == b.tempMotor && a.tempBattery == b.tempBattery &&
+           a.voltage == b.voltage && a.current == b.current && a.soc == b.soc;
+}
+
+int main(int argc, char** argv) {
+    ReplayOptions opt;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--every") == 0) opt.everyFrame = true;
+        else if(strcmp(argv[i], "--capture") == 0) opt.capture = true;
+        else if(strcmp(argv[i], "--quiet") == 0) opt.quiet = true;
+        else if(strcmp(argv[i], "--stats") == 0) opt.stats = true;
+        else if(strcmp(argv[i], "--step-ms") == 0 && i + 1 < argc) opt.stepMs = strtoul(argv[++i], nullptr, 10);
+        else if(argv[i][0] == '-' && argv[i][1] != '\0') { usage(argv[0]); return 2; }
+        else opt.input = argv[i];
+    }
+    if(!opt.input) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE* in = (strcmp(opt.input, "-") == 0) ? stdin : fopen(opt.input, "r");
+    if(!in) {
+        perror(opt.input);
+        return 1;
+    }
+
+    // Trace di stdout, log Serial firmware di stderr
+    Serial.setOutput(opt.quiet ? nullptr : stderr);
+    hostClockSetMicros(REPLAY_START_US);
+    foxVehicleInit();
+    foxStatsInit();
+    if(opt.capture) foxVehicleEnableUnknownCapture(true);
+
+    printTraceHeader();
+    foxHeapMarkSetupDone();
+
+    char line[512];
+    unsigned long lineNo = 0;
+    unsigned long frames = 0;
+    unsigned long rejected = 0;
+    bool haveOrigin = false;
+    uint64_t originUs = 0;
+    FoxVehicleData last = foxVehicleGetData();
+    uint32_t lastGeneration = foxVehicleGetGeneration();
+    std::chrono::nanoseconds decodeTime(0);
+
+    while(fgets(line, sizeof(line), in)) {
+        lineNo++;
+        ReplayFrame frame;
+        if(!parseLine(line, frame)) {
+            if(line[0] != '\n' && line[0] != '#') rejected++;
+            continue;
+        }
+
+        if(frame.hasTimestamp) {
+            if(!haveOrigin) {
+                originUs = frame.timestampUs;
+                haveOrigin = true;
+            }
+            // Selisih bertanda: frame yang mundur (log tidak urut) tidak memundurkan clock
+            int64_t t = (int64_t)REPLAY_START_US + (int64_t)(frame.timestampUs - originUs);
+            if(t > (int64_t)hostClockMicros()) hostClockSetMicros((uint64_t)t);
+        } else {
+            hostClockAdvanceMicros((uint64_t)opt.stepMs * 1000);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        foxVehicleUpdateFromCAN(frame.canId, frame.data, frame.len, micros());
+        const FoxVehicleData& data = foxVehicleGetDataRef();
+        decodeTime += std::chrono::steady_clock::now() - start;
+        frames++;
+
+        // Generation sama = belum ada publish baru, tidak perlu dibandingkan
+        uint32_t generation = foxVehicleGetGeneration();
+        bool published = (generation != lastGeneration);
+        lastGeneration = generation;
+
+        if(opt.everyFrame || (published && !sameTrace(data, last))) {
+            printTrace(data);
+            last = data;
+        }
+    }
+    if(in != stdin) fclose(in);
+
+    // Report tetap tampil walau --quiet
+    Serial.setOutput(stderr);
+    if(opt.capture) {
+        foxSnifferPrintReport();
+    }
+    if(opt.stats) {
+        foxStatsPrint();
+    }
+
+    FoxTripData trip = foxTripGetData();
+    fprintf(stderr, "replay: trip %.3f km, %.1f Wh used, %.1f Wh regen, %.1f Wh/km\n",
+            trip.distanceKm, trip.whUsed, trip.whRegen, trip.whPerKm);
+
+    fprintf(stderr, "replay: %lu heap allocations after init\n",
+            (unsigned long)foxHeapGetStats().allocsAfterSetup);
+
+    double seconds = decodeTime.count() / 1e9;
+    fprintf(stderr, "replay: %lu lines, %lu frames, %lu rejected, virtual %.3f s\n",
+            lineNo, frames, rejected, (hostClockMicros() - REPLAY_START_US) / 1e6);
+    if(frames > 0 && seconds > 0) {
+        fprintf(stderr, "replay: decode %.1f ns/frame, %.0f frames/s\n",
+                decodeTime.count() / (double)frames, frames / seconds);
+    }
+    return 0;
+}
@@ -0,0 +1,6 @@
+#ifndef HOST_ADAFRUIT_SPIDEVICE_H
+#define HOST_ADAFRUIT_SPIDEVICE_H
+
+// Kosong: Adafruit_GFX.h meng-include header BusIO ini, tapi fox_display tidak memakainya
+
+#endif
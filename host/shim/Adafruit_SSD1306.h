@@ -0,0 +1,61 @@
+#ifndef HOST_ADAFRUIT_SSD1306_H
+#define HOST_ADAFRUIT_SSD1306_H
+
+// =============================================
+// SSD1306 DI MEMORI (build host)
+// =============================================
+// Pengganti library Adafruit_SSD1306: framebuffer format page yang sama
+// (byte = 8 pixel vertikal, LSB di atas), gambar lewat Adafruit_GFX asli.
+// begin()/display() tidak menyentuh bus; fox_display mengirim frame sendiri
+// lewat fox_i2c ke shim Wire.
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_INVERSE 2
+
+#define SSD1306_EXTERNALVCC 0x01
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi = &Wire, int8_t rst_pin = -1)
+        : Adafruit_GFX(w, h), buffer((uint8_t*)calloc(1, w * ((h + 7) / 8))) {}
+    ~Adafruit_SSD1306() { free(buffer); }
+
+    bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0,
+               bool reset = true, bool periphBegin = true) {
+        return buffer != NULL;
+    }
+    void display() {}
+    void clearDisplay() { memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8)); }
+    uint8_t* getBuffer() { return buffer; }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if(x < 0 || x >= width() || y < 0 || y >= height()) return;
+        switch(getRotation()) {
+            case 1: { int16_t t = x; x = WIDTH - y - 1; y = t; break; }
+            case 2: x = WIDTH - x - 1; y = HEIGHT - y - 1; break;
+            case 3: { int16_t t = x; x = y; y = HEIGHT - t - 1; break; }
+        }
+        uint8_t& b = buffer[x + (y / 8) * WIDTH];
+        uint8_t bit = 1 << (y & 7);
+        if(color == SSD1306_WHITE) b |= bit;
+        else if(color == SSD1306_BLACK) b &= ~bit;
+        else if(color == SSD1306_INVERSE) b ^= bit;
+    }
+
+    bool getPixel(int16_t x, int16_t y) {
+        if(x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return false;
+        return (buffer[x + (y / 8) * WIDTH] >> (y & 7)) & 1;
+    }
+
+private:
+    uint8_t* buffer;
+};
+
+#endif
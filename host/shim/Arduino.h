@@ -0,0 +1,125 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// =============================================
+// ARDUINO SHIM UNTUK BUILD NATIVE LINUX
+// =============================================
+// Hanya bagian Arduino yang dipakai fox_vehicle / fox_canlog / fox_display:
+// millis()/micros() dari clock virtual, Serial ke FILE*, String sederhana, GPIO kosong.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define HEX 16
+#define DEC 10
+#define HIGH 1
+#define LOW 0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define PROGMEM
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef uint8_t byte;
+
+// String flash (F()) tidak dipakai firmware, hanya dideklarasikan untuk Adafruit_GFX
+class __FlashStringHelper;
+
+// ========== GPIO ==========
+// Tidak ada pin di host; dipakai recovery bus I2C di fox_display
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return HIGH; }
+
+// ========== CLOCK VIRTUAL ==========
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void hostClockSetMicros(uint64_t us);
+void hostClockAdvanceMicros(uint64_t us);
+uint64_t hostClockMicros();
+
+// ========== STRING ==========
+// Buffer di heap lewat malloc/realloc seperti WString Arduino (tanpa SSO), supaya setiap String
+// yang tidak kosong terlihat di penghitung alokasi fox_heap
+class String {
+public:
+    String(const char* str = "") { assign(str ? str : "", str ? strlen(str) : 0); }
+    String(const String& other) { assign(other.c_str(), other.len); }
+    String(String&& other) noexcept : buffer(other.buffer), len(other.len) { other.buffer = nullptr; other.len = 0; }
+    String(char c) { assign(&c, 1); }
+    String(int value, unsigned char base = DEC);
+    String(unsigned int value, unsigned char base = DEC);
+    String(long value, unsigned char base = DEC);
+    String(unsigned long value, unsigned char base = DEC);
+    ~String() { free(buffer); }
+
+    String& operator=(const String& other);
+    String& operator=(String&& other) noexcept;
+
+    const char* c_str() const { return buffer ? buffer : ""; }
+    unsigned int length() const { return (unsigned int)len; }
+
+    String& operator+=(const String& other) { append(other.c_str(), other.len); return *this; }
+    friend String operator+(const String& a, const String& b) { String result(a); result += b; return result; }
+    bool operator==(const String& other) const { return len == other.len && strcmp(c_str(), other.c_str()) == 0; }
+    bool operator==(const char* other) const { return strcmp(c_str(), other ? other : "") == 0; }
+    bool operator!=(const String& other) const { return !(*this == other); }
+
+    bool startsWith(const String& prefix) const { return prefix.len <= len && strncmp(c_str(), prefix.c_str(), prefix.len) == 0; }
+    String substring(unsigned int from) const { return substring(from, (unsigned int)len); }
+    String substring(unsigned int from, unsigned int to) const;
+    long toInt() const { return atol(c_str()); }
+    void trim();
+    void toUpperCase();
+
+private:
+    void assign(const char* str, size_t n);
+    void append(const char* str, size_t n);
+
+    char* buffer = nullptr;
+    size_t len = 0;
+};
+
+// ========== SERIAL ==========
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    int available() { return 0; }
+    String readStringUntil(char) { return String(); }
+
+    // NULL = senyap (dipakai replay/benchmark)
+    void setOutput(FILE* out) { output = out; }
+
+    size_t print(const char* str);
+    size_t print(const String& str) { return print(str.c_str()); }
+    size_t print(char c);
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(unsigned char value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(double value, int digits = 2);
+
+    size_t println() { return print("\n"); }
+    template<typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template<typename T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+    FILE* output = stdout;
+};
+
+extern HostSerial Serial;
+
+#endif
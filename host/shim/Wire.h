@@ -0,0 +1,37 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+// =============================================
+// WIRE SHIM
+// =============================================
+// Bus I2C tanpa device fisik: setiap address ACK, baca mengembalikan 0.
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+    void end() {}
+    void setClock(uint32_t frequency) {}
+    void setTimeOut(uint16_t timeOutMillis) {}
+
+    void beginTransmission(uint8_t address) {}
+    size_t write(uint8_t data) { return 1; }
+    size_t write(const uint8_t* data, size_t len) { return len; }
+    uint8_t endTransmission(bool sendStop = true) { return 0; }
+
+    uint8_t requestFrom(uint8_t address, uint8_t len) { readLeft = len; return len; }
+    int available() { return readLeft; }
+    int read() {
+        if(readLeft == 0) return -1;
+        readLeft--;
+        return 0;
+    }
+
+private:
+    uint8_t readLeft = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
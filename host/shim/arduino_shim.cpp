@@ -0,0 +1,221 @@
+#include "Arduino.h"
+#include "Print.h"
+#include "Wire.h"
+#include <ctype.h>
+#include <stdarg.h>
+
+HostSerial Serial;
+
+// ========== CLOCK VIRTUAL ==========
+// Waktu hanya maju lewat hostClock*() atau delay(), sehingga replay deterministik.
+static uint64_t hostMicros = 0;
+
+unsigned long millis() {
+    return (unsigned long)(hostMicros / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)hostMicros;
+}
+
+void delay(unsigned long ms) {
+    hostMicros += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+    hostMicros += us;
+}
+
+void hostClockSetMicros(uint64_t us) {
+    hostMicros = us;
+}
+
+void hostClockAdvanceMicros(uint64_t us) {
+    hostMicros += us;
+}
+
+uint64_t hostClockMicros() {
+    return hostMicros;
+}
+
+// ========== STRING ==========
+// Angka ditulis dari belakang ke buffer stack (seperti Print::printNumber), tanpa heap
+static const char* formatNumber(char* buffer, size_t size, unsigned long value, unsigned char base, bool negative) {
+    char* p = &buffer[size - 1];
+    *p = '\0';
+    do {
+        unsigned digit = value % base;
+        *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while(value);
+    if(negative) *--p = '-';
+    return p;
+}
+
+static const char* formatSigned(char* buffer, size_t size, long value, unsigned char base) {
+    bool negative = (value < 0 && base == DEC);
+    unsigned long magnitude = negative ? 0UL - (unsigned long)value : (unsigned long)value;
+    return formatNumber(buffer, size, magnitude, base, negative);
+}
+
+void String::assign(const char* str, size_t n) {
+    if(n == 0) {
+        free(buffer);
+        buffer = nullptr;
+        len = 0;
+        return;
+    }
+    // Sumber di dalam buffer sendiri (trim, substring ke diri sendiri): geser dulu sebelum realloc
+    if(buffer && str >= buffer && str <= buffer + len) {
+        memmove(buffer, str, n);
+        str = nullptr;
+    }
+    char* grown = (char*)realloc(buffer, n + 1);
+    if(!grown) return;
+    buffer = grown;
+    if(str) memcpy(buffer, str, n);
+    buffer[n] = '\0';
+    len = n;
+}
+
+void String::append(const char* str, size_t n) {
+    if(n == 0) return;
+    char* grown = (char*)realloc(buffer, len + n + 1);
+    if(!grown) return;
+    buffer = grown;
+    memcpy(buffer + len, str, n);
+    len += n;
+    buffer[len] = '\0';
+}
+
+String& String::operator=(const String& other) {
+    if(this != &other) assign(other.c_str(), other.len);
+    return *this;
+}
+
+String& String::operator=(String&& other) noexcept {
+    if(this != &other) {
+        free(buffer);
+        buffer = other.buffer;
+        len = other.len;
+        other.buffer = nullptr;
+        other.len = 0;
+    }
+    return *this;
+}
+
+String::String(int value, unsigned char base) : String((long)value, base) {}
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base) {
+    char buffer[40];
+    const char* text = formatSigned(buffer, sizeof(buffer), value, base);
+    assign(text, strlen(text));
+}
+
+String::String(unsigned long value, unsigned char base) {
+    char buffer[40];
+    const char* text = formatNumber(buffer, sizeof(buffer), value, base, false);
+    assign(text, strlen(text));
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if(to > len) to = (unsigned int)len;
+    if(from >= to) return String();
+    String result;
+    result.assign(c_str() + from, to - from);
+    return result;
+}
+
+void String::trim() {
+    size_t start = 0;
+    while(start < len && isspace((unsigned char)buffer[start])) start++;
+    size_t end = len;
+    while(end > start && isspace((unsigned char)buffer[end - 1])) end--;
+    assign(c_str() + start, end - start);
+}
+
+void String::toUpperCase() {
+    for(size_t i = 0; i < len; i++) buffer[i] = (char)toupper((unsigned char)buffer[i]);
+}
+
+// ========== SERIAL ==========
+size_t HostSerial::print(const char* str) {
+    if(!output) return 0;
+    return fputs(str, output) >= 0 ? strlen(str) : 0;
+}
+
+size_t HostSerial::print(char c) {
+    char buffer[2] = {c, '\0'};
+    return print(buffer);
+}
+
+size_t HostSerial::print(long value, int base) {
+    char buffer[40];
+    return print(formatSigned(buffer, sizeof(buffer), value, (unsigned char)base));
+}
+
+size_t HostSerial::print(unsigned long value, int base) {
+    char buffer[40];
+    return print(formatNumber(buffer, sizeof(buffer), value, (unsigned char)base, false));
+}
+
+size_t HostSerial::print(double value, int digits) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return print(buffer);
+}
+
+// Sama dengan Print::printf ESP32: buffer stack 64 byte, output lebih panjang pakai malloc
+size_t HostSerial::printf(const char* format, ...) {
+    char stackBuffer[64];
+    char* buffer = stackBuffer;
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int n = vsnprintf(stackBuffer, sizeof(stackBuffer), format, copy);
+    va_end(copy);
+    if(n < 0) {
+        va_end(args);
+        return 0;
+    }
+    if((size_t)n >= sizeof(stackBuffer)) {
+        buffer = (char*)malloc((size_t)n + 1);
+        if(!buffer) {
+            va_end(args);
+            return 0;
+        }
+        vsnprintf(buffer, (size_t)n + 1, format, args);
+    }
+    va_end(args);
+    size_t written = print(buffer);
+    if(buffer != stackBuffer) free(buffer);
+    return written;
+}
+
+// ========== PRINT ==========
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while(size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::print(long value, int base) {
+    char buffer[40];
+    return print(formatSigned(buffer, sizeof(buffer), value, (unsigned char)base));
+}
+
+size_t Print::print(unsigned long value, int base) {
+    char buffer[40];
+    return print(formatNumber(buffer, sizeof(buffer), value, (unsigned char)base, false));
+}
+
+size_t Print::print(double value, int digits) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return print(buffer);
+}
+
+// ========== WIRE ==========
+TwoWire Wire;